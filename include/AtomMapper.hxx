@@ -1,15 +1,21 @@
 #pragma once
 
 // C++
-#include <map>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <stdint.h>
 
 // cosmos
-#include <cosmos/thread/RWLock.hxx>
+#include <cosmos/thread/Mutex.hxx>
 
 // xpp
 #include <xpp/dso_export.h>
+#include <xpp/fwd.hxx>
 #include <xpp/types.hxx>
 
 namespace xpp {
@@ -20,11 +26,19 @@ namespace xpp {
  * in the future. If a mapping is not cached already then it is retrieved via
  * Xlib.
  *
- * This class is thread safe by means of a read-write lock. Read-access can
- * occur in parallel, write accesses (due to cache misses) are exclusive.
+ * Mappings are kept in a two-way index: a hash table from name to AtomID and
+ * a dense table from AtomID to name. Both indexes only ever grow and
+ * published entries are never modified or freed while the AtomMapper
+ * exists. This allows lookups that hit the cache to proceed without taking
+ * any lock at all. Cache misses are serialized via a mutex. When the hash
+ * table needs to grow, a new table is published atomically and the old one
+ * is kept around until destruction, so that concurrent readers never access
+ * freed memory.
  *
- * There is a global instance of this type `xpp::atom_mapper` that should be
- * used for centralized access to atom mapping features.
+ * Atom IDs are only valid on the X server they have been obtained from,
+ * thus each AtomMapper is bound to a single XDisplay. Each XDisplay owns an
+ * AtomMapper available via XDisplay::atomMapper(). The global instance
+ * `xpp::atom_mapper` is the one used for the default `xpp::display`.
  *
  * \note
  *
@@ -43,29 +57,109 @@ public: // functions
 	 **/
 	AtomID mapAtom(const std::string_view s) const;
 
+	/// Resolves all of the given names that aren't cached yet in one go.
+	/**
+	 * This uses a single round trip to the X server for all names that
+	 * aren't yet cached, instead of one round trip per name like
+	 * mapAtom() does. This is useful to avoid many sequential round trips
+	 * during application startup.
+	 *
+	 * \return The number of names that have been newly resolved.
+	 **/
+	size_t cacheAtoms(const std::vector<std::string_view> &names) const;
+
 	/// tries to do a reverse lookup to get the name of `atom`
+	/**
+	 * The returned reference stays valid for the lifetime of the
+	 * AtomMapper instance.
+	 **/
 	const std::string& mapName(const AtomID atom) const;
 
-	AtomMapper() = default;
+	/// Drops all cached mappings, e.g. when the display is reconnected.
+	/**
+	 * References returned from mapName() become invalid. This must not
+	 * be called while other threads use the mapper.
+	 **/
+	void clear();
+
+	/// Creates an atom cache for the given display.
+	explicit AtomMapper(XDisplay &disp = xpp::display) :
+			m_display{&disp}
+	{}
+
 	// the cache should not be copied for performance reasons
 	AtomMapper(const AtomMapper&) = delete;
 
+	~AtomMapper();
+
+protected: // types
+
+	/// A single cached mapping, never changed after it has been published.
+	struct Entry {
+		const std::string name;
+		const AtomID id;
+		const size_t hash;
+	};
+
+	/// Open addressing hash table keyed by atom name.
+	/**
+	 * The table is kept at a load factor of at most 50 %, thus linear
+	 * probing always terminates at an empty slot.
+	 **/
+	struct NameTable {
+		explicit NameTable(const size_t capacity);
+
+		/// capacity - 1, capacity is always a power of two.
+		const size_t mask;
+		/// number of occupied slots.
+		size_t used = 0;
+		std::unique_ptr<std::atomic<const Entry*>[]> slots;
+	};
+
+	/// The number of low AtomID bits that index into an IDChunk.
+	static constexpr size_t ID_CHUNK_BITS = 8;
+	/// The number of AtomIDs covered by the dense reverse lookup table.
+	/**
+	 * The X server hands out atom IDs sequentially starting from the
+	 * predefined atoms, thus practically all IDs fall into this range.
+	 * Atoms beyond it are still cached but looked up under lock.
+	 **/
+	static constexpr size_t DENSE_IDS = 65536;
+
+	/// Second level of the dense AtomID to Entry table.
+	using IDChunk = std::array<std::atomic<const Entry*>, 1 << ID_CHUNK_BITS>;
+
 protected: // functions
 
-	const std::string& cacheMiss(const AtomID atom) const;
-	AtomID cacheMiss(const std::string_view s) const;
+	const Entry* findName(const std::string_view s, const size_t hash) const;
+	const Entry* findID(const AtomID atom) const;
 
-protected: // types
+	/// Adds a new mapping to both indexes, m_update_lock must be held.
+	const Entry& insert(const std::string_view s, const AtomID atom) const;
+	/// Adds `entry` to `table` without checking the load factor.
+	static void insertName(NameTable &table, const Entry &entry);
 
-	/// The map container that maps strings to X atoms
-	using AtomMapping = std::map<std::string, AtomID>;
+	const std::string& cacheMiss(const AtomID atom) const;
+	AtomID cacheMiss(const std::string_view s) const;
 
 protected: // data
 
-	/// contains the actual cached mappings
-	mutable AtomMapping m_mappings;
-	/// synchronizes parallel read and update of `m_mappings`
-	cosmos::RWLock m_mappings_lock;
+	friend class XDisplay;
+
+	/// the display mappings are resolved on, updated when the XDisplay is moved.
+	XDisplay *m_display = nullptr;
+	/// the currently published name lookup table
+	mutable std::atomic<NameTable*> m_names = nullptr;
+	/// first level of the dense reverse lookup table, chunks are allocated on demand
+	mutable std::array<std::atomic<IDChunk*>, (DENSE_IDS >> ID_CHUNK_BITS)> m_ids{};
+	/// reverse lookup entries for AtomIDs beyond DENSE_IDS, protected by m_update_lock
+	mutable std::unordered_map<AtomID, const Entry*> m_sparse_ids;
+	/// stable storage for all cached mappings
+	mutable std::deque<Entry> m_entries;
+	/// outgrown name tables that might still be accessed by readers
+	mutable std::vector<std::unique_ptr<NameTable>> m_retired_names;
+	/// serializes cache updates, readers don't need it
+	cosmos::Mutex m_update_lock;
 };
 
 /// Global AtomMapper instance in libxpp for centralized caching.
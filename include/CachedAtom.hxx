@@ -1,15 +1,20 @@
 #pragma once
 
 // C++
+#include <initializer_list>
 #include <optional>
 #include <string_view>
 
 // xpp
 #include <xpp/dso_export.h>
+#include <xpp/fwd.hxx>
 #include <xpp/types.hxx>
 
 namespace xpp {
 
+/// Drops the resolved IDs of all registered CachedAtom instances, used internally.
+void forget_cached_atoms();
+
 /// Transparently obtained and cached AtomID
 /**
  * For Atom values that need to be looked up during runtime, mapping them
@@ -25,6 +30,10 @@ namespace xpp {
  *
  * Instances of this type should be declared constexpr to avoid non-literal
  * constants being used in its construction.
+ *
+ * The cached ID and the implicit conversion to AtomID refer to the default
+ * xpp::display. For other displays use atom(XDisplay&), which looks up
+ * the name in the display's AtomMapper.
  **/
 class XPP_API CachedAtom {
 public: // functions
@@ -55,10 +64,15 @@ public: // functions
 		return *m_id;
 	}
 
+	/// Returns the AtomID valid on the given display.
+	AtomID atom(XDisplay &disp) const;
+
 	constexpr std::string_view name() const { return m_name; }
 
 protected: // functions
 
+	friend void forget_cached_atoms();
+
 	void resolve() const;
 
 protected: // data
@@ -66,4 +80,41 @@ protected: // data
 	mutable std::optional<AtomID> m_id;
 };
 
+/// Registers additional CachedAtom instances for bulk resolution.
+/**
+ * All CachedAtom instances declared in xpp/atoms.hxx are resolved together
+ * during xpp::init() using a single request to the X server, instead of
+ * paying one round trip per atom on first use. Applications can register
+ * their own CachedAtom instances to take part in this. Atoms registered after
+ * xpp::init() will be resolved during the next call of
+ * resolve_cached_atoms().
+ *
+ * The registered instances need to stay valid for the rest of the program's
+ * lifetime, which is the case for constexpr global instances.
+ **/
+XPP_API void register_cached_atoms(const std::initializer_list<const CachedAtom*> atoms);
+
+/// Resolves all registered CachedAtom instances using a single round trip.
+/**
+ * This is called automatically during xpp::init(). The resolved atoms are
+ * also stored in the global xpp::atom_mapper, thus even copies of
+ * CachedAtom instances that haven't been registered will be able to resolve
+ * without talking to the X server.
+ *
+ * The time spent for resolving the atoms is reported via the libxpp debug
+ * logger.
+ *
+ * \return The number of atoms that have been newly resolved.
+ **/
+XPP_API size_t resolve_cached_atoms();
+
+/// Resolves all registered CachedAtom names on the given display using a single round trip.
+/**
+ * This is the variant of resolve_cached_atoms() for displays other than
+ * the default display. The resolved atoms are stored in the display's
+ * AtomMapper, thus CachedAtom::atom(XDisplay&) won't need to talk to the X
+ * server for them anymore.
+ **/
+XPP_API size_t resolve_cached_atoms(XDisplay &disp);
+
 } // end ns
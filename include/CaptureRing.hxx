@@ -0,0 +1,134 @@
+#pragma once
+
+// C++
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+// cosmos
+#include <cosmos/thread/Condition.hxx>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/fwd.hxx>
+#include <xpp/Image.hxx>
+#include <xpp/types.hxx>
+
+namespace xpp {
+
+/// Continuous capturing of window or screen contents into reusable buffers.
+/**
+ * The ring consists of a fixed number of Image slots, MIT-SHM backed if
+ * possible, see Image. Each call to capture() reads the configured area of
+ * the source drawable into a free slot and hands it out as a Frame. No
+ * memory is allocated per frame.
+ *
+ * A frame stays owned by the consumer until it is passed to release(). This
+ * allows to pass frames on to e.g. an encoder thread while the next frames
+ * are already captured. release() may be called from any thread. If all
+ * slots are in use then capture() blocks until a frame is released, thus
+ * the number of slots limits how far the consumer may lag behind.
+ *
+ * capture() and stream() perform Xlib calls and are subject to the usual
+ * threading rules of the display. The ring must not be destroyed while
+ * frames are still being processed.
+ **/
+class XPP_API CaptureRing {
+	CaptureRing(const CaptureRing&) = delete;
+	CaptureRing& operator=(const CaptureRing&) = delete;
+public: // types
+
+	using UseShm = Image::UseShm;
+
+	/// A captured frame, valid until it is passed to release().
+	struct Frame {
+		/// the captured pixels, the image extent is the capture area's size
+		const Image *image = nullptr;
+		/// the ring slot the frame occupies
+		size_t slot = 0;
+		/// running number of the frame, starting at zero
+		uint64_t sequence = 0;
+		/// time at which the capture finished
+		std::chrono::steady_clock::time_point time;
+	};
+
+	/// Receives frames from stream(), returns whether streaming should continue.
+	/**
+	 * The callback is responsible for releasing the frame, possibly
+	 * asynchronously.
+	 **/
+	using Callback = std::function<bool (const Frame&)>;
+
+public: // functions
+
+	/// Prepares capturing `area` of `source` into `slots` reusable images.
+	/**
+	 * `area` is given in coordinates of `source` and needs to lie
+	 * completely within it. The images are created with the default depth
+	 * of `disp`, which needs to match the depth of `source`.
+	 **/
+	CaptureRing(const DrawableID source, const WindowSpec area, const size_t slots = 3,
+			const UseShm use_shm = UseShm{true}, XDisplay &disp = xpp::display);
+
+	/// Prepares capturing `area` of the given window, e.g. the RootWin.
+	/**
+	 * If no area is given then the complete window is captured, its size
+	 * is determined once during construction.
+	 **/
+	explicit CaptureRing(const XWindow &source, const std::optional<WindowSpec> area = std::nullopt,
+			const size_t slots = 3, const UseShm use_shm = UseShm{true});
+
+	/// Captures the next frame into a free slot.
+	/**
+	 * Blocks until a slot is available. On error an exception is thrown,
+	 * the slot is not consumed in this case.
+	 **/
+	Frame capture();
+
+	/// Returns the slot of `frame` to the ring.
+	void release(const Frame &frame);
+
+	/// Repeatedly captures frames and passes them to `callback`.
+	/**
+	 * This continues until `callback` returns `false` or until
+	 * `max_frames` frames have been captured, if given.
+	 *
+	 * \return The number of frames passed to `callback`.
+	 **/
+	uint64_t stream(const Callback &callback, const std::optional<uint64_t> max_frames = std::nullopt);
+
+	/// Returns the captured area in coordinates of the source.
+	WindowSpec area() const { return m_area; }
+
+	size_t slots() const { return m_images.size(); }
+
+	/// Returns whether the frames are captured via MIT-SHM.
+	bool isShared() const { return m_images.front().isShared(); }
+
+protected: // functions
+
+	/// Waits for a free slot, marks it as busy and returns its index.
+	size_t acquireSlot();
+
+	void releaseSlot(const size_t slot);
+
+	void setup(const size_t slots, const UseShm use_shm);
+
+protected: // data
+
+	XDisplay &m_display;
+	DrawableID m_source;
+	WindowSpec m_area;
+	std::vector<Image> m_images;
+	/// which slots are currently handed out to the consumer
+	std::vector<bool> m_busy;
+	/// slot to try first in acquireSlot(), to cycle through all images
+	size_t m_next = 0;
+	uint64_t m_sequence = 0;
+	/// protects m_busy and signals released slots
+	cosmos::ConditionMutex m_lock;
+};
+
+} // end ns
@@ -0,0 +1,137 @@
+#pragma once
+
+// C++
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+// cosmos
+#include <cosmos/io/EventFile.hxx>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/EventLoop.hxx>
+#include <xpp/MPSCQueue.hxx>
+#include <xpp/XDisplay.hxx>
+
+namespace xpp {
+
+/// A dedicated I/O thread owning an XDisplay connection.
+/**
+ * With XInitThreads() every Xlib call from every thread contends on the
+ * display lock, and a thread blocked waiting for events or replies delays
+ * the requests of all other threads.
+ *
+ * This type offers an alternative: a single thread owns the display and
+ * runs an EventLoop on it. Other threads don't call into Xlib at all but
+ * submit operations via a lock-free MPSCQueue and receive a std::future for
+ * the result:
+ *
+ *     auto name = conn.submit([win](XDisplay &disp) {
+ *         return XWindow{win, disp}.getName();
+ *     });
+ *     std::cout << name.get() << "\n";
+ *
+ * All operations queued at the time the I/O thread wakes up are executed in
+ * one go within a RequestBatch, so their implicit flushes are merged into a
+ * single flush.
+ *
+ * In this mode libxpp can be initialized with `ThreadSafe{false}`, which
+ * skips XInitThreads() and avoids the Xlib locking overhead. The display
+ * may then only be used from within submitted operations and event handlers
+ * while the thread is running.
+ *
+ * Event handlers, timers and file descriptors can be registered on loop()
+ * before start(). They are invoked in the I/O thread.
+ **/
+class XPP_API ConnectionThread {
+public: // types
+
+	/// An operation to be carried out in the I/O thread.
+	using Operation = std::function<void (XDisplay&)>;
+
+public: // functions
+
+	explicit ConnectionThread(XDisplay &disp = xpp::display);
+
+	/// Stops the thread, if still running.
+	~ConnectionThread();
+
+	ConnectionThread(const ConnectionThread&) = delete;
+	ConnectionThread& operator=(const ConnectionThread&) = delete;
+
+	/// Returns the event loop run by the I/O thread.
+	/**
+	 * The loop must only be accessed before start() or from within the I/O
+	 * thread.
+	 **/
+	EventLoop& loop() { return m_loop; }
+
+	/// Starts the I/O thread.
+	void start();
+
+	/// Stops the I/O thread and waits for it to exit.
+	/**
+	 * Operations queued before this call are still carried out.
+	 * Operations queued afterwards remain in the queue until the thread
+	 * is started again. When the object is destroyed, remaining
+	 * operations are discarded and their futures report a broken promise.
+	 **/
+	void stop();
+
+	bool running() const { return m_thread.joinable(); }
+
+	/// Returns whether the caller is running in the I/O thread.
+	bool inConnectionThread() const {
+		return std::this_thread::get_id() == m_thread.get_id();
+	}
+
+	/// Queues an operation without waiting for its result.
+	/**
+	 * Exceptions thrown by the operation are logged and otherwise
+	 * ignored. This can be called from any thread.
+	 **/
+	void post(Operation op);
+
+	/// Queues an operation and returns a future for its result.
+	/**
+	 * `func` is invoked with the XDisplay in the I/O thread. Its return
+	 * value or any exception it throws is passed to the returned future.
+	 * This can be called from any thread.
+	 **/
+	template <typename FUNC>
+	auto submit(FUNC &&func) -> std::future<std::invoke_result_t<FUNC&, XDisplay&>> {
+		using Result = std::invoke_result_t<FUNC&, XDisplay&>;
+		// std::function requires copyable targets, thus share the task
+		auto task = std::make_shared<std::packaged_task<Result (XDisplay&)>>(std::forward<FUNC>(func));
+		auto ret = task->get_future();
+		post([task](XDisplay &disp) { (*task)(disp); });
+		return ret;
+	}
+
+protected: // functions
+
+	void threadMain();
+
+	/// Runs all queued operations.
+	void drain();
+
+protected: // data
+
+	XDisplay &m_display;
+	EventLoop m_loop;
+	cosmos::EventFile m_wakeup;
+	MPSCQueue<Operation> m_queue;
+	/// whether m_wakeup has been signaled but not yet consumed.
+	std::atomic<bool> m_wakeup_pending = false;
+	/// set in the I/O thread once the stop operation has been processed.
+	bool m_stopping = false;
+	/// incremented by start(), identifies the run a stop operation belongs to.
+	size_t m_run = 0;
+	std::thread m_thread;
+};
+
+} // end ns
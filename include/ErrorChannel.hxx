@@ -0,0 +1,131 @@
+#pragma once
+
+// C++
+#include <functional>
+#include <future>
+#include <optional>
+#include <vector>
+
+// X11
+#include <X11/Xlib.h>
+
+// cosmos
+#include <cosmos/thread/Mutex.hxx>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/RequestToken.hxx>
+#include <xpp/XDisplay.hxx>
+
+namespace xpp {
+
+/// Correlates asynchronous X errors with the requests that caused them.
+/**
+ * Requests without a reply, like XChangeProperty() or XCopyArea(), don't
+ * report errors synchronously. Xlib passes them to the global error handler
+ * at some later point, when data is read from the connection. Calling
+ * XDisplay::sync() after each such request reveals errors, but costs a
+ * full round trip each time.
+ *
+ * An ErrorChannel instead tracks the serial numbers of RequestToken
+ * objects returned from wrapper calls. Errors are matched against the
+ * pending tokens as they arrive. Once the server is known to have processed
+ * a token's requests, its callback or future receives the outcome:
+ *
+ *     ErrorChannel channel;
+ *     auto result = channel.watch(win.setProperty(atom, prop));
+ *     // ... other work causing replies or events to be read ...
+ *     channel.process();
+ *     result.get(); // throws X11Exception if the request failed
+ *
+ * Completion is detected via XDisplay::lastProcessedRequest(), which
+ * advances whenever a reply, event or error is read. Busy connections thus
+ * don't need any extra round trips. settle() forces the completion of all
+ * pending tokens with a single round trip.
+ *
+ * Errors that don't belong to a pending token are passed on to the
+ * previously active Xlib error handler. A token needs to be watched before
+ * the connection is read from again, otherwise its errors could already
+ * have been passed on. In multi-threaded programs this means that the
+ * thread issuing the requests should watch the token right away, while no
+ * other thread reads from the display.
+ **/
+class XPP_API ErrorChannel {
+public: // types
+
+	/// Callback receiving the outcome of a request.
+	/**
+	 * The error is unset if all requests of the token succeeded, otherwise
+	 * it contains the first error that occurred.
+	 **/
+	using Callback = std::function<void (const std::optional<XErrorEvent>&)>;
+
+public: // functions
+
+	explicit ErrorChannel(XDisplay &disp = xpp::display);
+
+	/// Stops tracking errors.
+	/**
+	 * Callbacks of pending tokens are not invoked anymore, futures
+	 * report a broken promise.
+	 **/
+	~ErrorChannel();
+
+	ErrorChannel(const ErrorChannel&) = delete;
+	ErrorChannel& operator=(const ErrorChannel&) = delete;
+
+	/// Invokes `cb` from process() once the outcome of `token` is known.
+	void watch(const RequestToken &token, Callback cb);
+
+	/// Returns a future that receives the outcome of `token`.
+	/**
+	 * The future throws an X11Exception if one of the requests failed.
+	 **/
+	std::future<void> watch(const RequestToken &token);
+
+	/// Completes all tokens whose requests have been processed by the server.
+	/**
+	 * This does not perform any I/O. It should be called regularly, e.g.
+	 * after dispatching events from an EventLoop.
+	 *
+	 * \return The number of completed tokens.
+	 **/
+	size_t process();
+
+	/// Synchronizes with the X server and completes all pending tokens.
+	/**
+	 * This costs a single round trip, regardless of the number of pending
+	 * tokens.
+	 *
+	 * \return The number of completed tokens.
+	 **/
+	size_t settle();
+
+	/// Returns the number of tokens whose outcome is not yet known.
+	size_t pending() const;
+
+protected: // types
+
+	struct Pending {
+		unsigned long first;
+		unsigned long last;
+		Callback cb;
+		std::optional<XErrorEvent> error;
+	};
+
+protected: // functions
+
+	/// Records `ev` if it belongs to a pending token.
+	bool recordError(Display *dis, const XErrorEvent &ev);
+
+protected: // data
+
+	XDisplay &m_display;
+	/// error sink registration.
+	size_t m_sink = 0;
+	/// protects m_pending, errors are recorded from the Xlib error handler.
+	mutable cosmos::Mutex m_lock;
+	std::vector<Pending> m_pending;
+};
+
+} // end ns
@@ -0,0 +1,149 @@
+#pragma once
+
+// C++
+#include <array>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// X11
+#include <X11/X.h>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/Event.hxx>
+#include <xpp/types.hxx>
+
+namespace xpp {
+
+/// How the EventCoalescer treats events of a certain type.
+enum class CoalescePolicy {
+	KEEP_ALL,   ///< pass on every event, the default
+	KEEP_LATEST ///< only pass on the latest of consecutive events with the same key
+};
+
+/// Merges bursts of events of which only the latest state is relevant.
+/**
+ * Moving or resizing windows can cause hundreds of MotionNotify and
+ * ConfigureNotify events per second, clients changing properties in a loop
+ * cause floods of PropertyNotify events. Often only the latest state
+ * matters for the application.
+ *
+ * Events are passed to push() and are collected in a run of coalescable
+ * events. For event types with policy KEEP_LATEST, an event replaces an
+ * earlier event in the run with the same key. The key consists of the event
+ * window and event type, for PropertyNotify additionally of the property
+ * atom and for ConfigureNotify of the configured window. Surviving events
+ * keep the relative order of their latest occurrence.
+ *
+ * Only consecutive events are merged: an event with policy KEEP_ALL first
+ * flushes the current run, then it is passed on itself. flush() needs to be
+ * called at the end of a batch of events, e.g. once no more events are
+ * queued, to pass on the remaining run.
+ *
+ * The coalescer can be attached to an EventLoop via
+ * EventLoop::setCoalescer().
+ **/
+class XPP_API EventCoalescer {
+public: // types
+
+	/// Function receiving events that passed the coalescer.
+	using Sink = std::function<void (const Event&)>;
+
+public: // functions
+
+	explicit EventCoalescer(Sink sink = {}) :
+			m_sink{std::move(sink)} {
+		m_policies.fill(CoalescePolicy::KEEP_ALL);
+		m_dropped_per_type.fill(0);
+	}
+
+	void setSink(Sink sink) { m_sink = std::move(sink); }
+
+	void setPolicy(const EventType type, const CoalescePolicy policy) {
+		m_policies.at(cosmos::to_integral(type)) = policy;
+	}
+
+	CoalescePolicy policy(const EventType type) const {
+		const auto index = static_cast<size_t>(cosmos::to_integral(type));
+		return index < m_policies.size() ? m_policies[index] : CoalescePolicy::KEEP_ALL;
+	}
+
+	/// Sets KEEP_LATEST for MotionNotify, ConfigureNotify and PropertyNotify.
+	void setDefaultPolicies() {
+		setPolicy(EventType::MOTION_NOTIFY, CoalescePolicy::KEEP_LATEST);
+		setPolicy(EventType::CONFIGURE_NOTIFY, CoalescePolicy::KEEP_LATEST);
+		setPolicy(EventType::PROPERTY_NOTIFY, CoalescePolicy::KEEP_LATEST);
+	}
+
+	/// Feeds the next event into the coalescer.
+	void push(const Event &event);
+
+	/// Passes on all events still held back.
+	void flush();
+
+	/// Returns the number of events currently held back.
+	size_t pending() const { return m_run.size() - m_run_dropped; }
+
+	/// Returns the total number of events dropped.
+	size_t dropped() const { return m_dropped; }
+
+	/// Returns the number of events of the given type dropped.
+	size_t dropped(const EventType type) const {
+		const auto index = static_cast<size_t>(cosmos::to_integral(type));
+		return index < m_dropped_per_type.size() ? m_dropped_per_type[index] : 0;
+	}
+
+	void resetCounters() {
+		m_dropped = 0;
+		m_dropped_per_type.fill(0);
+	}
+
+protected: // types
+
+	struct Key {
+		WinID event_win;
+		/// the configured window for ConfigureNotify.
+		WinID subject;
+		AtomID atom;
+		int type;
+
+		bool operator==(const Key &other) const {
+			return event_win == other.event_win && subject == other.subject &&
+				atom == other.atom && type == other.type;
+		}
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key &key) const {
+			size_t ret = std::hash<unsigned long>{}(cosmos::to_integral(key.event_win));
+			ret = ret * 31 + cosmos::to_integral(key.subject);
+			ret = ret * 31 + cosmos::to_integral(key.atom);
+			return ret * 31 + static_cast<size_t>(key.type);
+		}
+	};
+
+	struct Slot {
+		Event event;
+		bool dropped = false;
+	};
+
+protected: // functions
+
+	static Key makeKey(const Event &event);
+
+protected: // data
+
+	Sink m_sink;
+	std::array<CoalescePolicy, LASTEvent> m_policies;
+	/// the current run of coalescable events.
+	std::vector<Slot> m_run;
+	/// number of dropped slots in m_run.
+	size_t m_run_dropped = 0;
+	/// maps event keys to their latest slot in m_run.
+	std::unordered_map<Key, size_t, KeyHash> m_latest;
+	size_t m_dropped = 0;
+	std::array<size_t, LASTEvent> m_dropped_per_type;
+};
+
+} // end ns
@@ -0,0 +1,209 @@
+#pragma once
+
+// C++
+#include <array>
+#include <cstddef>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <optional>
+#include <unordered_map>
+
+// X11
+#include <X11/X.h>
+
+// cosmos
+#include <cosmos/fs/FileDescriptor.hxx>
+#include <cosmos/io/Poller.hxx>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/Event.hxx>
+#include <xpp/EventCoalescer.hxx>
+#include <xpp/fwd.hxx>
+#include <xpp/types.hxx>
+#include <xpp/XDisplay.hxx>
+
+namespace xpp {
+
+/// Poll based event loop dispatching X events, file descriptor events and timers.
+/**
+ * XDisplay::nextEvent() blocks the calling thread and checking for events via
+ * XDisplay::getPendingEvents() can flush the output buffer and read from the
+ * connection. This type instead monitors the X connection file descriptor
+ * together with any number of additional file descriptors using
+ * cosmos::Poller. When the connection becomes readable, all available
+ * events are read and dispatched in one batch.
+ *
+ * X events are dispatched via a flat table indexed by EventType. Handlers
+ * can be registered for the generic Event type or for a concrete event
+ * wrapper type like ConfigureEvent or PropertyEvent:
+ *
+ *     loop.setHandler<PropertyEvent>(EventType::PROPERTY_NOTIFY,
+ *         [](const PropertyEvent &ev) { ... });
+ *
+ * Timers are kept in a list of deadlines that determines the poll timeout,
+ * thus a single thread can serve X events, other I/O and timers without
+ * busy polling.
+ *
+ * This type is not thread safe, all functions need to be called from the
+ * thread running the loop. stop() can be called from within handlers.
+ **/
+class XPP_API EventLoop {
+public: // types
+
+	using Clock = std::chrono::steady_clock;
+
+	/// Generic handler for X events.
+	using EventHandler = std::function<void (const Event&)>;
+	/// Handler for file descriptor activity and timers.
+	using Callback = std::function<void ()>;
+
+	/// Identifier for a timer returned from addTimer().
+	enum class TimerID : size_t {
+		INVALID = 0
+	};
+
+public: // functions
+
+	/// Creates an event loop for the given display.
+	explicit EventLoop(XDisplay &disp = xpp::display);
+
+	/// Creates an event loop without an X display.
+	/**
+	 * Such a loop only serves file descriptors, timers and events passed
+	 * to dispatch() explicitly, e.g. events replayed from a recording via
+	 * EventReplay. This allows to exercise event handlers without an X
+	 * server.
+	 **/
+	explicit EventLoop(std::nullptr_t);
+
+	~EventLoop();
+
+	EventLoop(const EventLoop&) = delete;
+	EventLoop& operator=(const EventLoop&) = delete;
+
+	/// Registers a handler for events of the given type.
+	/**
+	 * Any previously registered handler for this type is replaced. An
+	 * empty handler removes the registration.
+	 **/
+	void setHandler(const EventType type, EventHandler handler) {
+		m_handlers.at(cosmos::to_integral(type)) = std::move(handler);
+	}
+
+	/// Registers a handler for events of the given type that receives a typed event wrapper.
+	/**
+	 * EVENT needs to be a wrapper type constructible from `const Event&`
+	 * matching `type`, like MapEvent for EventType::MAP_NOTIFY.
+	 **/
+	template <typename EVENT>
+	void setHandler(const EventType type, std::function<void (const EVENT&)> handler) {
+		setHandler(type, [handler = std::move(handler)](const Event &event) {
+			handler(EVENT{event});
+		});
+	}
+
+	/// Registers a handler for events for which no specific handler is set.
+	void setDefaultHandler(EventHandler handler) {
+		m_default_handler = std::move(handler);
+	}
+
+	/// Passes X events through the given coalescer before dispatching them.
+	/**
+	 * The coalescer's sink is set to dispatch(). The coalescer is flushed
+	 * after each batch of events read from the display. Passing `nullptr`
+	 * disables coalescing again. The coalescer object needs to stay valid
+	 * while it is set.
+	 **/
+	void setCoalescer(EventCoalescer *coalescer);
+
+	/// Monitors `fd` for input and invokes `cb` when it becomes readable.
+	void addFD(const cosmos::FileDescriptor fd, Callback cb);
+
+	/// Stops monitoring `fd`.
+	void removeFD(const cosmos::FileDescriptor fd);
+
+	/// Invokes `cb` after `delay` has passed.
+	/**
+	 * If `interval` is set then the timer is rearmed with this interval
+	 * each time it fires, until it is removed. The minimum interval is
+	 * one millisecond.
+	 **/
+	TimerID addTimer(const std::chrono::milliseconds delay, Callback cb,
+			const std::optional<std::chrono::milliseconds> interval = std::nullopt);
+
+	/// Cancels the given timer.
+	/**
+	 * \return Whether the timer was still active.
+	 **/
+	bool removeTimer(const TimerID id);
+
+	/// Runs the loop until stop() is called.
+	void run();
+
+	/// Performs a single iteration of the loop.
+	/**
+	 * This processes queued X events, flushes the output buffer, waits
+	 * for activity for at most `timeout` (and not longer than the next
+	 * timer deadline) and dispatches everything that happened.
+	 **/
+	void runOnce(const std::optional<std::chrono::milliseconds> timeout = std::nullopt);
+
+	/// Makes run() return after the current iteration.
+	void stop() { m_running = false; }
+
+	/// Dispatches a single event to the registered handler.
+	/**
+	 * This is used internally for events received from the display, but
+	 * can also be used for events from other sources, e.g. for testing.
+	 *
+	 * \return Whether a handler was found for the event.
+	 **/
+	bool dispatch(const Event &event) const;
+
+	/// Dispatches all events already present in the local event queue.
+	/**
+	 * This does not perform any I/O.
+	 *
+	 * \return The number of events taken from the queue. If a coalescer
+	 * is set then fewer events might have been dispatched.
+	 **/
+	size_t dispatchQueued();
+
+protected: // types
+
+	struct Timer {
+		TimerID id;
+		Callback cb;
+		std::optional<std::chrono::milliseconds> interval;
+	};
+
+	/// Timers ordered by their deadline.
+	using TimerList = std::multimap<Clock::time_point, Timer>;
+
+protected: // functions
+
+	/// Runs all timers whose deadline has passed.
+	void runTimers();
+
+	/// Returns the time to wait until the next timer deadline, if any.
+	std::optional<std::chrono::milliseconds> nextTimeout() const;
+
+protected: // data
+
+	/// the display to process events for, if any.
+	XDisplay *m_display = nullptr;
+	cosmos::Poller m_poller;
+	cosmos::FileDescriptor m_x_fd;
+	/// flat handler table indexed by EventType.
+	std::array<EventHandler, LASTEvent> m_handlers;
+	EventHandler m_default_handler;
+	EventCoalescer *m_coalescer = nullptr;
+	std::unordered_map<cosmos::FileNum, Callback> m_fd_callbacks;
+	TimerList m_timers;
+	size_t m_next_timer_id = 1;
+	bool m_running = false;
+};
+
+} // end ns
@@ -0,0 +1,125 @@
+#pragma once
+
+// C++
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <string>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/Event.hxx>
+#include <xpp/fwd.hxx>
+
+namespace xpp {
+
+/**
+ * @file
+ *
+ * Recording of X event streams into files and replaying them without an X
+ * server.
+ *
+ * The file format is a simple binary format in native byte order, thus
+ * recordings are only portable between machines of the same architecture:
+ *
+ * - file header: 8 bytes magic "XPPEVREC", uint32_t format version,
+ *   uint32_t sizeof(XEvent) on the recording machine.
+ * - per event: uint64_t nanoseconds since the start of the recording,
+ *   int32_t event type, uint16_t size of the event data, followed by the
+ *   event data. Only the part of the XEvent union used by the event type is
+ *   stored.
+ *
+ * Pointers contained in events (like the Display pointer) are meaningless
+ * in replayed events and are reset to `nullptr`.
+ **/
+
+/// Writes X events into a binary recording file.
+/**
+ * A recorder can be attached to an XDisplay via
+ * XDisplay::setEventRecorder(), then all events returned from
+ * XDisplay::nextEvent() are recorded. Events can also be recorded
+ * explicitly via record(), e.g. to create synthetic recordings.
+ **/
+class XPP_API EventRecorder {
+public: // functions
+
+	/// Creates a new recording in the file at `path`.
+	/**
+	 * An existing file will be truncated. On error a cosmos::RuntimeError
+	 * is thrown.
+	 **/
+	explicit EventRecorder(const std::string &path);
+
+	/// Appends `event` to the recording, using the current time.
+	void record(const Event &event);
+
+	/// Appends `event` to the recording with an explicit timestamp.
+	/**
+	 * `offset` is the time since the start of the recording. This is
+	 * mostly useful for creating synthetic recordings.
+	 **/
+	void record(const Event &event, const std::chrono::nanoseconds offset);
+
+	/// Writes out any buffered data.
+	void flush();
+
+	/// Returns the number of events recorded so far.
+	size_t numEvents() const { return m_num_events; }
+
+protected: // data
+
+	std::ofstream m_file;
+	std::chrono::steady_clock::time_point m_start;
+	size_t m_num_events = 0;
+};
+
+/// Reads X events from a recording created by EventRecorder.
+class XPP_API EventReplay {
+public: // types
+
+	enum class Timing {
+		ORIGINAL, ///< reproduce the time gaps between events as recorded
+		FAST      ///< pass on events as fast as possible
+	};
+
+	using Sink = std::function<void (const Event&)>;
+
+public: // functions
+
+	/// Opens the recording in the file at `path`.
+	/**
+	 * On error or if the file is not a valid recording then a
+	 * cosmos::RuntimeError is thrown.
+	 **/
+	explicit EventReplay(const std::string &path);
+
+	/// Reads the next event from the recording.
+	/**
+	 * \param[out] offset The time of the event relative to the start of
+	 * the recording.
+	 *
+	 * \return `false` if the end of the recording has been reached.
+	 **/
+	bool next(Event &event, std::chrono::nanoseconds &offset);
+
+	/// Passes all remaining events to `sink`.
+	/**
+	 * The events can e.g. be passed to EventLoop::dispatch().
+	 *
+	 * \return The number of events replayed.
+	 **/
+	size_t replay(const Sink &sink, const Timing timing = Timing::FAST);
+
+	/// Starts reading from the beginning of the recording again.
+	void rewind();
+
+protected: // data
+
+	std::ifstream m_file;
+	std::streampos m_data_start;
+};
+
+/// Returns the number of bytes of the XEvent union used by the given event type.
+XPP_API size_t event_data_size(const EventType type);
+
+} // end ns
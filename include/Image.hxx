@@ -0,0 +1,176 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+// X11
+#include <X11/Xlib.h>
+
+// cosmos
+#include <cosmos/utils.hxx>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/fwd.hxx>
+#include <xpp/RequestToken.hxx>
+#include <xpp/types.hxx>
+
+namespace xpp {
+
+namespace errors {
+	class RequestCatcher;
+}
+
+/// Client side pixel buffer that can be transferred from/to pixmaps and windows.
+/**
+ * The image uses the ZPixmap format with the default visual and depth of
+ * the display. The layout of the pixel data is described by
+ * bytesPerLine() and bitsPerPixel(), for the common 24-bit TrueColor
+ * visuals each pixel is a 32-bit value in native byte order.
+ *
+ * If the X server supports the MIT-SHM extension and is running on the
+ * local machine then the pixel data is placed in a shared memory segment.
+ * putImage() and getImage() then only transfer a small request instead of
+ * all of the pixel data through the socket. Otherwise the image falls back to plain
+ * XPutImage() transparently, see isShared().
+ *
+ * With MIT-SHM the server reads the pixel data asynchronously. Before
+ * modifying the pixel data after a putImage() call, waitIdle() needs to be
+ * called to make sure the server is done with it.
+ *
+ * This is a move only type, since there are resources behind this object
+ * that need to be freed at the appropriate time.
+ **/
+class XPP_API Image {
+	Image(const Image&) = delete;
+	Image& operator=(const Image&) = delete;
+public: // types
+
+	/// Whether to try to use a MIT-SHM segment for the pixel data.
+	using UseShm = cosmos::NamedBool<struct use_shm_t, true>;
+
+public: // functions
+
+	Image();
+
+	/// Creates an image of the given size.
+	/**
+	 * If the image cannot be created at all then an exception is thrown.
+	 * Failing to set up shared memory is not an error, the image falls
+	 * back to plain memory in this case.
+	 **/
+	explicit Image(const Extent extent, const UseShm use_shm = UseShm{true},
+			XDisplay &disp = xpp::display);
+
+	Image(Image &&other) noexcept;
+
+	Image& operator=(Image &&other) noexcept;
+
+	~Image();
+
+	bool valid() const { return m_image != nullptr; }
+
+	/// Returns whether the pixel data lives in a MIT-SHM segment.
+	bool isShared() const { return m_shm != nullptr; }
+
+	Extent extent() const {
+		return valid() ? Extent{
+			static_cast<unsigned>(m_image->width),
+			static_cast<unsigned>(m_image->height)} : Extent{};
+	}
+
+	int depth() const { return m_image->depth; }
+
+	int bitsPerPixel() const { return m_image->bits_per_pixel; }
+
+	/// Returns the number of bytes between the start of two rows.
+	size_t bytesPerLine() const { return m_image->bytes_per_line; }
+
+	/// Returns the complete pixel data.
+	std::span<uint8_t> data() {
+		return {reinterpret_cast<uint8_t*>(m_image->data), bytesPerLine() * m_image->height};
+	}
+
+	std::span<const uint8_t> data() const {
+		return {reinterpret_cast<const uint8_t*>(m_image->data), bytesPerLine() * m_image->height};
+	}
+
+	/// Returns a pointer to the start of row `y`.
+	uint8_t* row(const unsigned y) {
+		return data().data() + y * bytesPerLine();
+	}
+
+	/// Uploads the image or the `area` of it to `target` at position `dst`.
+	/**
+	 * The target needs to have the same depth as the image, `gc` needs to
+	 * be valid for the target.
+	 *
+	 * \return A token for the request, errors are only reported
+	 * asynchronously.
+	 **/
+	RequestToken putImage(const DrawableID target, const GraphicsContext &gc,
+			const Coord dst = Coord{}, const std::optional<WindowSpec> area = std::nullopt);
+
+	RequestToken putImage(const Pixmap &target, const GraphicsContext &gc,
+			const Coord dst = Coord{}, const std::optional<WindowSpec> area = std::nullopt);
+
+	RequestToken putImage(const XWindow &target, const GraphicsContext &gc,
+			const Coord dst = Coord{}, const std::optional<WindowSpec> area = std::nullopt);
+
+	/// Fills the image with the contents of `source` starting at `src`.
+	/**
+	 * The extent of the image determines the size of the area that is
+	 * read, which needs to lie completely within `source`. The source
+	 * needs to have the same depth as the image. With MIT-SHM the data is
+	 * written by the server directly into the shared segment.
+	 *
+	 * This waits for the server's reply. On error an exception is thrown.
+	 **/
+	void getImage(const DrawableID source, const Coord src = Coord{});
+
+	void getImage(const XWindow &source, const Coord src = Coord{});
+
+	/// Blocks until the server finished reading the pixel data.
+	/**
+	 * This is only necessary for shared images. It performs a round trip
+	 * to the X server if the last putImage() request is not yet known to
+	 * be processed.
+	 **/
+	void waitIdle();
+
+	/// Frees the image resources.
+	void destroy();
+
+protected: // types
+
+	/// Wraps the Xlib MIT-SHM segment information.
+	struct ShmSegment;
+
+protected: // functions
+
+	bool createShared(const Extent extent);
+
+	void createPlain(const Extent extent);
+
+	/// getImage() implementation without MIT-SHM, copying from an XCB reply into m_buffer.
+	void getPlainImage(const DrawableID source, const Coord src);
+
+protected: // data
+
+	XDisplay *m_display = nullptr;
+	XImage *m_image = nullptr;
+	/// the shared memory segment, if MIT-SHM is in use
+	std::unique_ptr<ShmSegment> m_shm;
+	/// the pixel data if MIT-SHM is not in use
+	std::vector<uint8_t> m_buffer;
+	/// catches errors of MIT-SHM requests, registered once per image
+	std::unique_ptr<errors::RequestCatcher> m_catcher;
+	/// the last putImage() request, to know when shared data may be modified
+	RequestToken m_last_put;
+};
+
+} // end ns
@@ -0,0 +1,108 @@
+#pragma once
+
+// C
+#include <stdint.h>
+
+// C++
+#include <array>
+#include <chrono>
+#include <map>
+#include <string>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/EventLoop.hxx>
+#include <xpp/fwd.hxx>
+
+/**
+ * @file
+ *
+ * Optional instrumentation of the X protocol traffic caused by libxpp.
+ *
+ * Many libxpp calls cause blocking round trips to the X server, which is not
+ * obvious from the outside. If libxpp is built with XPP_INSTRUMENT defined
+ * (`scons instrument=1`) then the library counts requests, round trips,
+ * flushes and transferred property bytes per XDisplay and records latency
+ * histograms per wrapper function like XWindow::getProperty().
+ *
+ * Without XPP_INSTRUMENT the instrumentation points compile to nothing. The
+ * functions in this header are still available, enabled() returns `false`
+ * and all counters and histograms stay empty.
+ **/
+
+namespace xpp {
+
+/// Protocol level counters of a single X display connection.
+struct RequestCounters {
+	/// number of requests issued on the connection since the last reset.
+	uint64_t requests = 0;
+	/// number of calls blocking until a reply from the X server arrived.
+	uint64_t round_trips = 0;
+	/// number of explicit flushes of the output buffer (including syncs).
+	uint64_t flushes = 0;
+	/// number of property payload bytes sent to the X server.
+	uint64_t bytes_sent = 0;
+	/// number of property payload bytes received from the X server.
+	uint64_t bytes_received = 0;
+};
+
+/// Latency distribution of calls to a single wrapper function.
+/**
+ * Bucket `i` counts calls that took [2^i, 2^(i+1)) nanoseconds, the last
+ * bucket counts all calls taking longer.
+ **/
+struct LatencyHistogram {
+	static constexpr size_t BUCKETS = 36;
+
+	std::array<uint64_t, BUCKETS> buckets{};
+	/// number of calls recorded.
+	uint64_t calls = 0;
+	/// number of requests issued during the recorded calls.
+	uint64_t requests = 0;
+	uint64_t total_ns = 0;
+	uint64_t max_ns = 0;
+
+	/// Returns the average call duration in nanoseconds.
+	double mean() const {
+		return calls ? static_cast<double>(total_ns) / calls : 0.0;
+	}
+
+	/// Returns an upper bound in nanoseconds for the given percentile of call durations.
+	uint64_t percentile(const unsigned pct) const;
+};
+
+/// Latency histograms keyed by wrapper function name.
+using LatencyTable = std::map<std::string, LatencyHistogram>;
+
+namespace instrumentation {
+
+/// Returns whether libxpp has been built with XPP_INSTRUMENT.
+XPP_API bool enabled();
+
+/// Returns the current counters for the given display.
+XPP_API RequestCounters counters(XDisplay &disp);
+
+/// Returns a snapshot of the latency histograms of all wrappers called so far.
+XPP_API LatencyTable latencies();
+
+/// Resets all counters and histograms.
+XPP_API void reset();
+
+/// Writes a summary of counters and histograms to the libxpp logger.
+/**
+ * The summary is written at info level to the logger passed to
+ * xpp::init().
+ **/
+XPP_API void dump(XDisplay &disp);
+
+/// Calls dump() periodically from the given event loop.
+/**
+ * The returned timer can be passed to EventLoop::removeTimer() to stop
+ * dumping again.
+ **/
+XPP_API EventLoop::TimerID dump_periodically(EventLoop &loop, XDisplay &disp,
+		const std::chrono::milliseconds interval);
+
+} // end ns instrumentation
+
+} // end ns
@@ -0,0 +1,94 @@
+#pragma once
+
+// C++
+#include <atomic>
+#include <utility>
+
+namespace xpp {
+
+/// Unbounded lock-free multi-producer single-consumer queue.
+/**
+ * This is Dmitry Vyukov's intrusive MPSC node based queue. Any number of
+ * threads can push() concurrently, pushing is wait-free and consists of a
+ * single atomic exchange. Only a single thread may pop().
+ *
+ * There is a short window in which a push() has been started but is not yet
+ * visible to the consumer. pop() then reports an empty queue, although the
+ * element will show up shortly. Consumers thus need a separate wakeup
+ * mechanism that is triggered after push() returned.
+ *
+ * T needs to be default constructible and movable.
+ **/
+template <typename T>
+class MPSCQueue {
+public: // functions
+
+	MPSCQueue() :
+			m_head{new Node{}},
+			m_tail{m_head.load(std::memory_order_relaxed)} {
+	}
+
+	~MPSCQueue() {
+		T discard;
+		while (pop(discard)) {
+			;
+		}
+
+		delete m_tail;
+	}
+
+	MPSCQueue(const MPSCQueue&) = delete;
+	MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+	/// Adds an element to the queue, can be called from any thread.
+	void push(T value) {
+		auto node = new Node{std::move(value)};
+		auto prev = m_head.exchange(node, std::memory_order_acq_rel);
+		// from here on the consumer can reach the new node
+		prev->next.store(node, std::memory_order_release);
+	}
+
+	/// Takes the oldest element from the queue, only to be called from the consumer thread.
+	/**
+	 * \return `false` if no element is currently available.
+	 **/
+	bool pop(T &out) {
+		auto tail = m_tail;
+		auto next = tail->next.load(std::memory_order_acquire);
+
+		if (!next)
+			return false;
+
+		// `next` becomes the new stub node, its value is moved out
+		out = std::move(next->value);
+		m_tail = next;
+		delete tail;
+		return true;
+	}
+
+	/// Returns whether the queue is currently empty, only reliable in the consumer thread.
+	bool empty() const {
+		return m_tail->next.load(std::memory_order_acquire) == nullptr;
+	}
+
+protected: // types
+
+	struct Node {
+		Node() = default;
+
+		explicit Node(T &&v) :
+				value{std::move(v)} {}
+
+		std::atomic<Node*> next = nullptr;
+		T value;
+	};
+
+protected: // data
+
+	/// the most recently pushed node, modified by producers.
+	alignas(64) std::atomic<Node*> m_head;
+	/// the stub node preceding the oldest element, owned by the consumer.
+	alignas(64) Node *m_tail;
+};
+
+} // end ns
@@ -4,10 +4,23 @@
 #include <cosmos/error/UsageError.hxx>
 
 // xpp
+#include <xpp/fwd.hxx>
 #include <xpp/PropertyTraits.hxx>
 
 namespace xpp {
 
+/// Determines the native2x() scratch buffer type of TRAITS, an empty type if there is none.
+template <typename TRAITS>
+struct PropertyScratch {
+	struct type {};
+};
+
+template <typename TRAITS>
+	requires requires { typename TRAITS::Scratch; }
+struct PropertyScratch<TRAITS> {
+	using type = typename TRAITS::Scratch;
+};
+
 /// X11 property representation.
 /**
  * Based on the PropertyTraits definitions this class allows to have C++
@@ -26,6 +39,8 @@ class Property {
 	// The XWindow class is actually doing the communication via Xlib so
 	// it needs to mess with the Property internals
 	friend class XWindow;
+	// the same is true for batched queries
+	friend class PropertyBatch;
 
 public: // types
 
@@ -34,6 +49,13 @@ public: // types
 	/// The correct pointer type for our property type
 	typedef typename PropertyTraits<PROPTYPE>::XPtrType XPtrType;
 
+protected: // types
+
+	static constexpr bool HAS_SCRATCH = requires { typename Traits::Scratch; };
+
+	/// Conversion buffer for native2x(), if needed by the traits.
+	using Scratch = typename PropertyScratch<Traits>::type;
+
 public: // functions
 
 	/// Construct an empty/default property value
@@ -78,7 +100,12 @@ public: // functions
 		checkDelete();
 
 		m_native = p;
-		Traits::native2x(m_native, m_data);
+
+		if constexpr (HAS_SCRATCH) {
+			Traits::native2x(m_native, m_data, m_scratch);
+		} else {
+			Traits::native2x(m_native, m_data);
+		}
 
 		return *this;
 	}
@@ -110,8 +137,25 @@ protected: // functions
 	}
 
 	/// Retrieves the associated AtomID from the traits of PROPTYPE.
+	/**
+	 * The returned ID is valid on the default display.
+	 **/
 	static AtomID getXType() { return Traits::x_type; }
 
+	/// Retrieves the associated AtomID valid on the given display.
+	/**
+	 * Most property types use predefined atoms which are the same on any
+	 * display, only types that are resolved at runtime need to be looked
+	 * up per display.
+	 **/
+	static AtomID getXType(XDisplay &disp) {
+		if constexpr (requires { Traits::x_type_atom; }) {
+			return Traits::x_type_atom->atom(disp);
+		} else {
+			return Traits::x_type;
+		}
+	}
+
 	/// If the current Property instance contains data allocated by Xlib then it is deleted.
 	void checkDelete() {
 		// frees the ptr data if it comes from xlib
@@ -130,6 +174,8 @@ private: // data
 	bool m_data_is_from_x = false;
 	/// A pointer to m_native that can be fed to Xlib
 	typename Traits::XPtrType m_data = nullptr;
+	/// Reused buffer for converting m_native into X data
+	[[no_unique_address]] Scratch m_scratch;
 };
 
 } // end ns
@@ -0,0 +1,113 @@
+#pragma once
+
+// C++
+#include <vector>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/fwd.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/types.hxx>
+
+// XCB type used in protected interfaces
+struct xcb_get_property_reply_t;
+
+namespace xpp {
+
+/// Pipelined retrieval of many properties from many windows.
+/**
+ * XWindow::getProperty() performs a blocking round trip to the X server for
+ * each property. When querying a number of properties from a large number of
+ * windows, e.g. for taking a snapshot of all client windows, this sums up to
+ * a lot of latency.
+ *
+ * This type allows to queue typed Property reads for arbitrary (window,
+ * property) pairs. fetch() first sends out all requests and only then
+ * collects the replies, thus the complete batch costs roughly a single round
+ * trip.
+ *
+ * Errors are not reported via exceptions but via a PropertyStatus per item.
+ * This is because when scanning arbitrary windows, missing properties or
+ * vanished windows are a normal condition.
+ *
+ * The Property objects passed to add() need to stay valid until fetch()
+ * returns.
+ **/
+class XPP_API PropertyBatch {
+public: // functions
+
+	explicit PropertyBatch(XDisplay &disp = xpp::display) :
+			m_display{&disp}
+	{}
+
+	/// Queue a query of `property` from `win` to be stored in `out`.
+	/**
+	 * \param[in] max_len The maximum number of bytes of property data
+	 * to retrieve. If the property is larger then the item will report
+	 * PropertyStatus::TRUNCATED.
+	 *
+	 * \return An index for the new item to be used with status().
+	 **/
+	template <typename PROPTYPE>
+	size_t add(const WinID win, const AtomID property, Property<PROPTYPE> &out, const size_t max_len = 65536) {
+		m_items.push_back(Item{
+			win, property,
+			Property<PROPTYPE>::getXType(*m_display),
+			PropertyTraits<PROPTYPE>::FORMAT,
+			&out, &decode<PROPTYPE>, max_len});
+		return m_items.size() - 1;
+	}
+
+	/// Sends out all queued queries and collects the replies.
+	/**
+	 * After this call returns all items will have a status other than
+	 * PropertyStatus::PENDING. The batch can be fetched again to refresh
+	 * the properties, or cleared to be reused for a different set of
+	 * queries.
+	 **/
+	void fetch();
+
+	/// Returns the status of the given item.
+	PropertyStatus status(const size_t item) const {
+		return m_items.at(item).status;
+	}
+
+	/// Returns the number of queued items.
+	size_t size() const { return m_items.size(); }
+
+	/// Removes all queued items.
+	void clear() { m_items.clear(); }
+
+protected: // types
+
+	/// Type erased function for passing received data to a typed Property.
+	using DecodeFunc = void (*)(void *prop, unsigned char *data, unsigned long size);
+
+	struct Item {
+		WinID win;
+		AtomID property;
+		AtomID type;
+		int format;
+		void *prop;
+		DecodeFunc decode;
+		size_t max_len;
+		PropertyStatus status = PropertyStatus::PENDING;
+	};
+
+protected: // functions
+
+	template <typename PROPTYPE>
+	static void decode(void *prop, unsigned char *data, unsigned long size) {
+		static_cast<Property<PROPTYPE>*>(prop)->takeData(data, size);
+	}
+
+	/// Passes the data from an XCB property reply to the item's Property.
+	void process(Item &item, xcb_get_property_reply_t *reply);
+
+protected: // data
+
+	XDisplay *m_display = nullptr;
+	std::vector<Item> m_items;
+};
+
+} // end ns
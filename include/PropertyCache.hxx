@@ -0,0 +1,242 @@
+#pragma once
+
+// C++
+#include <cstring>
+#include <list>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// cosmos
+#include <cosmos/utils.hxx>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/fwd.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/types.hxx>
+#include <xpp/utf8_string.hxx>
+#include <xpp/XWindow.hxx>
+
+namespace xpp {
+
+/// An opt-in local cache for window properties.
+/**
+ * Every XWindow::getProperty() call is a round trip to the X server.
+ * Programs that read the same properties again and again, e.g. window name,
+ * desktop or class of client windows, can use this type to keep decoded
+ * property values locally instead.
+ *
+ * Entries are keyed by (WinID, property AtomID). On the first access of a
+ * window, the cache selects PropertyNotify and StructureNotify events via
+ * XWindow::mergeEventSelection(), which keeps events the application
+ * already selected for the window. The application needs to pass all
+ * events received to processEvent(), which drops exactly the entry a
+ * PropertyNotify event is about. DestroyNotify events drop all entries of
+ * the destroyed window.
+ *
+ * The total size of the cached data is limited to a configurable number of
+ * bytes. When the limit is exceeded, the least recently used entries are
+ * evicted.
+ *
+ * References returned from get() stay valid until the entry is invalidated
+ * or evicted. It is best to copy the data or to process it right away.
+ *
+ * Since window IDs are only unique per X server, a cache should only be
+ * used with windows of a single XDisplay.
+ *
+ * This type is not thread safe.
+ **/
+class XPP_API PropertyCache {
+public: // types
+
+	/// Whether to select PropertyNotify and DestroyNotify events on newly accessed windows.
+	using SelectEvents = cosmos::NamedBool<struct select_events_t, true>;
+
+	/// Usage statistics of the cache.
+	struct Stats {
+		/// number of get() calls served from the cache.
+		size_t hits = 0;
+		/// number of get() calls that required a round trip.
+		size_t misses = 0;
+		/// number of entries dropped due to the size limit.
+		size_t evictions = 0;
+		/// number of entries dropped due to events.
+		size_t invalidations = 0;
+	};
+
+public: // functions
+
+	/// Creates a cache limited to approximately `max_bytes` of property data.
+	explicit PropertyCache(const size_t max_bytes = 1024 * 1024,
+			const SelectEvents select = SelectEvents{true}) :
+			m_max_bytes{max_bytes},
+			m_select_events{select}
+	{}
+
+	/// Returns the value of `property` from `win`, from the cache if possible.
+	/**
+	 * On a cache miss the property is retrieved via
+	 * XWindow::getProperty(), thus the same exceptions can be thrown.
+	 * Failed queries are not cached.
+	 *
+	 * If the property is cached with a different PROPTYPE then the cache
+	 * entry is replaced.
+	 **/
+	template <typename PROPTYPE>
+	const PROPTYPE& get(const XWindow &win, const AtomID property) {
+		const Key key{win.id(), property};
+
+		if (auto it = m_entries.find(key); it != m_entries.end()) {
+			if (auto value = dynamic_cast<Value<PROPTYPE>*>(it->second.value.get()); value) {
+				m_stats.hits++;
+				touch(it->second);
+				return value->prop.get();
+			}
+
+			erase(it);
+		}
+
+		m_stats.misses++;
+
+		watch(win);
+
+		auto value = std::make_unique<Value<PROPTYPE>>();
+		win.getProperty(property, value->prop);
+		value->bytes = dataSize(value->prop.get());
+		auto &ret = value->prop.get();
+		insert(key, std::move(value));
+		return ret;
+	}
+
+	/// Updates the cache based on the given event.
+	/**
+	 * \return Whether the event was relevant for the cache.
+	 **/
+	bool processEvent(const Event &event);
+
+	/// Drops the cached `property` of `win`, if present.
+	void invalidate(const WinID win, const AtomID property);
+
+	/// Drops all cached properties of `win`.
+	void invalidate(const WinID win);
+
+	/// Drops all cached properties.
+	void clear();
+
+	/// Returns whether the given property is currently cached.
+	bool contains(const WinID win, const AtomID property) const {
+		return m_entries.find(Key{win, property}) != m_entries.end();
+	}
+
+	/// Returns the number of cached properties.
+	size_t size() const { return m_entries.size(); }
+
+	/// Returns the approximate number of bytes of cached property data.
+	size_t bytes() const { return m_bytes; }
+
+	/// Changes the maximum number of bytes, evicting entries if necessary.
+	void setMaxBytes(const size_t max_bytes);
+
+	size_t maxBytes() const { return m_max_bytes; }
+
+	const Stats& stats() const { return m_stats; }
+
+	void resetStats() { m_stats = Stats{}; }
+
+protected: // types
+
+	struct Key {
+		WinID win;
+		AtomID property;
+
+		bool operator==(const Key &other) const {
+			return win == other.win && property == other.property;
+		}
+	};
+
+	struct KeyHash {
+		size_t operator()(const Key &key) const {
+			const auto win = cosmos::to_integral(key.win);
+			const auto atom = cosmos::to_integral(key.property);
+			return std::hash<unsigned long>{}(win * 31 + atom);
+		}
+	};
+
+	/// Type erased owner of a cached Property.
+	struct ValueBase {
+		virtual ~ValueBase() {}
+		size_t bytes = 0;
+	};
+
+	/// Owns the Property, which in turn owns the X data backing the native value.
+	template <typename PROPTYPE>
+	struct Value : ValueBase {
+		Property<PROPTYPE> prop;
+	};
+
+	using LRUList = std::list<Key>;
+
+	struct Entry {
+		std::unique_ptr<ValueBase> value;
+		/// position in m_lru.
+		LRUList::iterator lru_pos;
+	};
+
+	using EntryMap = std::unordered_map<Key, Entry, KeyHash>;
+
+protected: // functions
+
+	/// Selects PropertyNotify events on `win` if not done yet.
+	void watch(const XWindow &win);
+
+	void insert(const Key &key, std::unique_ptr<ValueBase> value);
+
+	void erase(EntryMap::iterator it);
+
+	/// Marks the entry as most recently used.
+	void touch(Entry &entry) {
+		m_lru.splice(m_lru.begin(), m_lru, entry.lru_pos);
+	}
+
+	/// Evicts least recently used entries until the size limit is met.
+	void shrink();
+
+	/// Approximates the number of bytes used by a native property value.
+	template <typename T>
+	static size_t dataSize(const T&) { return sizeof(T); }
+
+	static size_t dataSize(const char *s) { return std::strlen(s); }
+
+	static size_t dataSize(const utf8_string &s) { return s.str.size(); }
+
+	template <typename ELEM>
+	static size_t dataSize(const std::vector<ELEM> &v) {
+		if constexpr (std::is_same_v<ELEM, utf8_string>) {
+			size_t ret = 0;
+			for (const auto &s: v) {
+				ret += dataSize(s) + 1;
+			}
+			return ret;
+		} else {
+			return v.size() * sizeof(ELEM);
+		}
+	}
+
+protected: // data
+
+	size_t m_max_bytes = 0;
+	size_t m_bytes = 0;
+	bool m_select_events = true;
+	EntryMap m_entries;
+	/// cache keys ordered from most to least recently used.
+	LRUList m_lru;
+	/// windows PropertyNotify events have been selected for.
+	std::unordered_set<WinID> m_watched;
+	Stats m_stats;
+};
+
+} // end ns
@@ -0,0 +1,65 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+// xpp
+#include <xpp/CachedAtom.hxx>
+#include <xpp/Property.hxx>
+
+namespace xpp {
+
+/// A string literal usable as a template argument.
+template <size_t N>
+struct fixed_string {
+	consteval fixed_string(const char (&str)[N]) {
+		std::copy_n(str, N, data);
+	}
+
+	constexpr std::string_view view() const { return std::string_view{data, N - 1}; }
+
+	char data[N]{};
+};
+
+/// Compile-time binding of a property name to its C++ type.
+/**
+ * Accessing properties by name via XWindow::getProperty(const
+ * cosmos::SysString, ...) and similar requires a lookup of the atom for
+ * each call, and the C++ type used for the property has to be repeated at
+ * each call site. A PropertyKey instead binds the atom name and the
+ * PROPTYPE together at compile time:
+ *
+ *     constexpr PropertyKey<"_NET_WM_NAME", utf8_string> net_wm_name;
+ *
+ *     Property<utf8_string> name;
+ *     win.getProperty(net_wm_name, name);
+ *
+ * The atom is resolved once per display and then cached. Passing a
+ * Property of a different type than the key's is a compile error rather
+ * than a runtime PropertyTypeMismatch.
+ **/
+template <fixed_string NAME, typename PROPTYPE>
+struct PropertyKey {
+	using Type = PROPTYPE;
+	using Traits = PropertyTraits<PROPTYPE>;
+	using PropertyType = Property<PROPTYPE>;
+
+	/// Whether the X type of the property is known at compile time.
+	/**
+	 * This is the case for all types using predefined atoms. Only types
+	 * like utf8_string need to resolve their type atom at runtime.
+	 **/
+	static constexpr bool STATIC_X_TYPE = !requires { Traits::x_type_atom; };
+
+	static constexpr std::string_view name() { return NAME.view(); }
+
+	/// The atom of the property name, shared by all instances of this key.
+	static constexpr CachedAtom atom{NAME.view()};
+
+	/// Returns the AtomID of the property name valid on `disp`.
+	static AtomID atomFor(XDisplay &disp) { return atom.atom(disp); }
+};
+
+} // end ns
@@ -0,0 +1,118 @@
+#pragma once
+
+// C++
+#include <deque>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/fwd.hxx>
+#include <xpp/types.hxx>
+#include <xpp/XWindow.hxx>
+
+namespace xpp {
+
+/// Streaming reader for large window properties.
+/**
+ * XWindow::getProperty() retrieves a property completely into memory. Some
+ * properties like _NET_WM_ICON can be several megabytes in size. This type
+ * allows to read such properties in chunks of a configurable size, so that
+ * they can be processed incrementally using bounded memory.
+ *
+ * To hide the latency of the individual requests, a configurable number of
+ * chunk requests are kept in flight (read-ahead). The first request is sized
+ * according to the size observed for the same property atom in earlier
+ * reads (or according to an explicitly passed PropertyInfo). If this size
+ * fits into the read-ahead window then typical properties arrive in a single
+ * round trip.
+ *
+ * The data is returned in X11 wire format, i.e. 32-bit format data consists
+ * of 32-bit items, not of C `long` like Xlib returns it. Chunks of 32-bit
+ * format properties always contain complete items.
+ *
+ * If the property changes while it is being read then a
+ * cosmos::RuntimeError is thrown from next().
+ **/
+class XPP_API PropertyReader {
+public: // functions
+
+	/// Prepares reading `property` from `win` and sends out the first request.
+	/**
+	 * \param[in] chunk_size The number of bytes to request at once, will
+	 * be rounded up to a multiple of four.
+	 * \param[in] read_ahead The number of chunk requests to keep in
+	 * flight, at least one.
+	 * \param[in] info Optional known metadata of the property for sizing
+	 * the first request.
+	 **/
+	PropertyReader(const XWindow &win, const AtomID property,
+			const size_t chunk_size = 64 * 1024,
+			const size_t read_ahead = 2,
+			const XWindow::PropertyInfo *info = nullptr);
+
+	/// Discards any replies still pending.
+	~PropertyReader();
+
+	PropertyReader(const PropertyReader&) = delete;
+	PropertyReader& operator=(const PropertyReader&) = delete;
+
+	/// Returns the next chunk of property data.
+	/**
+	 * `chunk` receives the data, its length, its offset into the property
+	 * and the number of bytes left after it. The chunk is valid even after
+	 * the reader has been destroyed.
+	 *
+	 * Throws XWindow::PropertyNotExisting if the property is not present
+	 * and XWindow::PropertyQueryError if the query failed.
+	 *
+	 * \return `false` if the property has been read completely and no
+	 * chunk has been returned.
+	 **/
+	bool next(RawProperty &chunk);
+
+	/// The type of the property, known after the first call to next().
+	AtomID type() const { return m_type; }
+
+	/// The format of the property (8, 16 or 32), known after the first call to next().
+	int format() const { return m_format; }
+
+	/// The total size of the property in bytes, known after the first call to next().
+	size_t totalBytes() const { return m_total; }
+
+	/// The number of bytes returned via next() so far.
+	size_t bytesRead() const { return m_read; }
+
+	/// Returns whether the complete property has been returned.
+	bool done() const { return m_pending.empty(); }
+
+protected: // types
+
+	struct Request {
+		unsigned int sequence;
+		size_t offset;
+	};
+
+protected: // functions
+
+	void request(const size_t offset, const size_t length);
+
+	/// Sends new requests until the read-ahead window is filled.
+	void fillPipeline();
+
+protected: // data
+
+	XDisplay &m_display;
+	const WinID m_win;
+	const AtomID m_property;
+	const size_t m_chunk_size;
+	const size_t m_read_ahead;
+	std::deque<Request> m_pending;
+	/// offset of the next byte to request.
+	size_t m_next_offset = 0;
+	size_t m_total = 0;
+	size_t m_read = 0;
+	AtomID m_type = AtomID::INVALID;
+	int m_format = 0;
+	bool m_have_info = false;
+};
+
+} // end ns
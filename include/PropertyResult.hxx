@@ -0,0 +1,90 @@
+#pragma once
+
+// C++
+#include <optional>
+#include <utility>
+
+// cosmos
+#include <cosmos/error/UsageError.hxx>
+
+// xpp
+#include <xpp/types.hxx>
+
+namespace xpp {
+
+/// The value of a property query or the reason why it is not available.
+/**
+ * This is similar to `std::expected<T, PropertyStatus>`. It is returned
+ * from the `try*` getters of XWindow that report missing or mistyped
+ * properties without throwing. Failures don't allocate any memory.
+ *
+ *     if (auto pid = win.tryGetPID(); pid) {
+ *         std::cout << *pid << "\n";
+ *     } else if (pid.status() == PropertyStatus::NOT_EXISTING) {
+ *         ...
+ *     }
+ **/
+template <typename T>
+class PropertyResult {
+public: // functions
+
+	/// Creates a successful result.
+	PropertyResult(T value) :
+			m_status{PropertyStatus::OK},
+			m_value{std::move(value)} {
+	}
+
+	/// Creates a failed result, `status` must not be PropertyStatus::OK.
+	PropertyResult(const PropertyStatus status) :
+			m_status{status} {
+	}
+
+	bool hasValue() const { return m_value.has_value(); }
+
+	explicit operator bool() const { return hasValue(); }
+
+	PropertyStatus status() const { return m_status; }
+
+	/// Returns the value, throws a UsageError if there is none.
+	const T& value() const & {
+		check();
+		return *m_value;
+	}
+
+	T& value() & {
+		check();
+		return *m_value;
+	}
+
+	T&& value() && {
+		check();
+		return std::move(*m_value);
+	}
+
+	/// Returns the value or `fallback` if there is none.
+	template <typename U>
+	T valueOr(U &&fallback) const & {
+		return m_value ? *m_value : static_cast<T>(std::forward<U>(fallback));
+	}
+
+	const T& operator*() const & { return *m_value; }
+	T& operator*() & { return *m_value; }
+
+	const T* operator->() const { return &*m_value; }
+	T* operator->() { return &*m_value; }
+
+protected: // functions
+
+	void check() const {
+		if (!m_value) {
+			throw cosmos::UsageError{"accessing the value of a failed PropertyResult"};
+		}
+	}
+
+protected: // data
+
+	PropertyStatus m_status;
+	std::optional<T> m_value;
+};
+
+} // end ns
@@ -1,7 +1,11 @@
 #pragma once
 
 // C++
+#include <algorithm>
 #include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 // X11
@@ -9,6 +13,7 @@
 
 // xpp
 #include <xpp/atoms.hxx>
+#include <xpp/text.hxx>
 #include <xpp/utf8_string.hxx>
 
 namespace xpp {
@@ -50,6 +55,14 @@ public: // constants
 	static constexpr char FORMAT = 0;
 	/// A pointer to PROPTYPE that can be passed to the X11 functions for retrieving / passing data.
 	using XPtrType = float*;
+	/*
+	 * Optionally a `Scratch` type can be declared that native2x() needs
+	 * for converting data. Xlib expects 32-bit format data as an array of
+	 * `long`, which is wider than e.g. `int` on 64-bit platforms. Traits
+	 * declaring this type receive an instance of it kept in the Property
+	 * object as third native2x() parameter. Since the buffer is reused,
+	 * repeated assignments don't need to allocate.
+	 */
 
 public: // functions
 
@@ -78,6 +91,10 @@ public: // functions
 	}
 
 	/// Transform the current value of the native PROPTYPE into raw X data
+	/**
+	 * If the traits declare a Scratch type then the signature is
+	 * `native2x(const PROPTYPE&, XPtrType&, Scratch&)`.
+	 **/
 	static void native2x(const PROPTYPE &s, XPtrType &data) {
 		(void)s; (void)data;
 	}
@@ -94,6 +111,7 @@ public: // constants
 	static constexpr unsigned long FIXED_SIZE = sizeof(int);
 	static constexpr char FORMAT = 32;
 	using XPtrType = long*;
+	using Scratch = long;
 
 public: // functions
 
@@ -105,9 +123,11 @@ public: // functions
 		(void)count;
 	}
 
-	static void native2x(const int &s, XPtrType &data) {
-		// We simply set the pointer to the PROPTYPE item as a flat copy.
-		data = (XPtrType)&s;
+	static void native2x(const int &s, XPtrType &data, Scratch &scratch) {
+		// Xlib reads a long for format 32, which is wider than int on
+		// 64-bit platforms
+		scratch = s;
+		data = &scratch;
 	}
 };
 
@@ -175,17 +195,27 @@ public: // constants
 
 public: // functions
 
+	static int numElements(const WinID&) { return 1; }
+
 	static void x2native(WinID &w, XPtrType data, unsigned int count) {
 		w = WinID{static_cast<Window>(*data)};
 		(void)count;
 	}
+
+	static void native2x(const WinID &w, XPtrType &data) {
+		static_assert(sizeof(WinID) == sizeof(long));
+		data = (XPtrType)&w;
+	}
 };
 
 template <>
 class PropertyTraits<utf8_string> {
 public: // constants
 
+	/// the type atom on the default display.
 	static AtomID x_type;
+	/// the type atom on arbitrary displays.
+	static constexpr const CachedAtom *x_type_atom = &atoms::ewmh_utf8_string;
 	static constexpr unsigned long FIXED_SIZE = 0;
 	static constexpr char FORMAT = 8;
 	using XPtrType = const char*;
@@ -224,14 +254,38 @@ public: // constants
 	static constexpr unsigned long FIXED_SIZE = 0;
 	static constexpr char FORMAT = PropertyTraits<ELEM>::FORMAT;
 	using XPtrType = typename PropertyTraits<ELEM>::XPtrType;
+	using XElem = std::remove_pointer_t<XPtrType>;
+	using Scratch = std::vector<XElem>;
 
 public: // functions
 
+	static int numElements(const std::vector<ELEM> &v) { return v.size(); }
+
 	static void x2native(std::vector<ELEM> &v, XPtrType data, unsigned int count) {
+		v.clear();
+		v.reserve(count);
+
 		for (unsigned int e = 0; e < count; e++) {
 			v.push_back(ELEM(data[e]));
 		}
 	}
+
+	static void native2x(const std::vector<ELEM> &v, XPtrType &data, Scratch &scratch) {
+		if constexpr (sizeof(ELEM) == sizeof(XElem)) {
+			if (!v.empty()) {
+				// the elements already have the width Xlib expects
+				data = (XPtrType)v.data();
+				return;
+			}
+		}
+
+		// keep a valid pointer even for empty vectors
+		scratch.resize(std::max<size_t>(v.size(), 1));
+		std::transform(v.begin(), v.end(), scratch.begin(), [](const ELEM e) {
+			return static_cast<XElem>(e);
+		});
+		data = scratch.data();
+	}
 };
 
 template <>
@@ -239,6 +293,7 @@ class PropertyTraits<std::vector<utf8_string>> {
 public: // constants
 
 	static AtomID x_type;
+	static constexpr const CachedAtom *x_type_atom = PropertyTraits<utf8_string>::x_type_atom;
 	static constexpr unsigned long FIXED_SIZE = 0;
 	static constexpr char FORMAT = PropertyTraits<utf8_string>::FORMAT;
 	using XPtrType = const char*;
@@ -251,15 +306,40 @@ public: // functions
 		x_type = PropertyTraits<utf8_string>::x_type;
 	}
 
+	using Scratch = std::string;
+
+	static int numElements(const std::vector<utf8_string> &v) {
+		size_t ret = 0;
+		for (const auto &s: v) {
+			// each string is null terminated
+			ret += s.str.size() + 1;
+		}
+		return ret;
+	}
+
+	static void native2x(const std::vector<utf8_string> &v, XPtrType &data, Scratch &scratch) {
+		scratch.clear();
+
+		for (const auto &s: v) {
+			scratch.append(s.str);
+			scratch.push_back('\0');
+		}
+
+		data = scratch.data();
+	}
+
 	static void x2native(std::vector<utf8_string> &v, XPtrType data, unsigned int count) {
-		// we get a char* sequence of zero-terminated strings here
+		// we get a char* sequence of zero-terminated strings here, the
+		// ranges are kept to avoid allocations on repeated calls
+		thread_local std::vector<std::string_view> ranges;
+		// broken encodings are tolerated, see utf8_string::valid()
+		(void)text::split_list(std::string_view{data, count}, ranges);
+
 		v.clear();
+		v.reserve(ranges.size());
 
-		while (count != 0) {
-			v.push_back(utf8_string(data));
-			const auto consumed = v.back().length() + 1;
-			count -= consumed;
-			data += consumed;
+		for (const auto range: ranges) {
+			v.push_back(utf8_string{range});
 		}
 	}
 };
@@ -273,16 +353,28 @@ public: // constants
 	static constexpr unsigned long FIXED_SIZE = 0;
 	static constexpr char FORMAT = 32;
 	using XPtrType = long*;
+	using Scratch = std::vector<long>;
 
 public: // functions
 
+	static int numElements(const std::vector<int> &v) { return v.size(); }
+
 	static void x2native(std::vector<int> &v, XPtrType data, unsigned int count) {
 		v.clear();
+		v.reserve(count);
 
 		for (unsigned int e = 0; e < count; e++) {
 			v.push_back(data[e]);
 		}
 	}
+
+	static void native2x(const std::vector<int> &v, XPtrType &data, Scratch &scratch) {
+		// widen to long as expected by Xlib, keep a valid pointer even
+		// for empty vectors
+		scratch.resize(std::max<size_t>(v.size(), 1));
+		std::copy(v.begin(), v.end(), scratch.begin());
+		data = scratch.data();
+	}
 };
 
 template <>
@@ -293,14 +385,33 @@ public: // constants
 	static constexpr unsigned long FIXED_SIZE = 0;
 	static constexpr char FORMAT = 32;
 	using XPtrType = long*;
+	using Scratch = std::vector<long>;
 
 public: // functions
 
+	static int numElements(const std::vector<AtomID> &v) { return v.size(); }
+
 	static void x2native(std::vector<AtomID> &v, XPtrType data, unsigned int count) {
+		v.clear();
+		v.reserve(count);
+
 		for (unsigned int e = 0; e < count; e++) {
 			v.push_back(AtomID{static_cast<Atom>(data[e])});
 		}
 	}
+
+	static void native2x(const std::vector<AtomID> &v, XPtrType &data, Scratch &scratch) {
+		static_assert(sizeof(AtomID) == sizeof(long));
+
+		if (!v.empty()) {
+			data = (XPtrType)v.data();
+			return;
+		}
+
+		// an empty vector may not have any storage, keep a valid pointer
+		scratch.assign(1, 0);
+		data = scratch.data();
+	}
 };
 
 } // end ns
@@ -0,0 +1,272 @@
+#pragma once
+
+// C++
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+// cosmos
+#include <cosmos/error/UsageError.hxx>
+
+// xpp
+#include <xpp/PropertyTraits.hxx>
+
+namespace xpp {
+
+/// Read-only view on list property data owned by a Property object.
+/**
+ * The PropertyTraits for `std::vector<ELEM>` copy each element of a list
+ * property into a new vector. For large list properties like
+ * _NET_CLIENT_LIST this copying dominates the cost of retrieving the
+ * property. Using `Property<PropertyView<ELEM>>` instead, the data stays in
+ * the buffer received from Xlib, which is owned by the Property object, and
+ * is only converted into ELEM on access.
+ *
+ * This is only supported for 32-bit format properties like lists of AtomID,
+ * WinID or int. For lists of strings the specialization
+ * PropertyView<utf8_string> exists.
+ *
+ * \warning The view is only valid as long as the Property object it has been
+ * obtained from is alive and unchanged.
+ **/
+template <typename ELEM>
+class PropertyView {
+public: // types
+
+	using value_type = ELEM;
+	using size_type = size_t;
+
+	/// Iterator converting the raw Xlib items into ELEM on the fly.
+	class Iterator {
+	public: // types
+
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = ELEM;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = ELEM;
+
+	public: // functions
+
+		Iterator() = default;
+
+		explicit Iterator(const long *pos) :
+				m_pos{pos} {}
+
+		ELEM operator*() const { return convert(*m_pos); }
+
+		Iterator& operator++() {
+			++m_pos;
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			auto ret = *this;
+			++m_pos;
+			return ret;
+		}
+
+		bool operator==(const Iterator &other) const { return m_pos == other.m_pos; }
+		bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+	protected: // data
+
+		const long *m_pos = nullptr;
+	};
+
+public: // functions
+
+	PropertyView() = default;
+
+	PropertyView(const long *data, const size_t count) :
+			m_items{data, count} {}
+
+	size_t size() const { return m_items.size(); }
+
+	bool empty() const { return m_items.empty(); }
+
+	Iterator begin() const { return Iterator{m_items.data()}; }
+	Iterator end() const { return Iterator{m_items.data() + m_items.size()}; }
+
+	ELEM operator[](const size_t index) const {
+		return convert(m_items[index]);
+	}
+
+	/// Like operator[] but with bounds checking.
+	ELEM at(const size_t index) const {
+		if (index >= m_items.size()) {
+			cosmos_throw (cosmos::UsageError("PropertyView index out of range"));
+		}
+
+		return convert(m_items[index]);
+	}
+
+	/// Returns the raw items as provided by Xlib.
+	/**
+	 * Note that Xlib always stores 32-bit format data in `long`, which is
+	 * 64 bits wide on 64-bit platforms.
+	 **/
+	std::span<const long> raw() const { return m_items; }
+
+protected: // functions
+
+	static ELEM convert(const long item) {
+		if constexpr (std::is_enum_v<ELEM>) {
+			return ELEM{static_cast<std::underlying_type_t<ELEM>>(item)};
+		} else {
+			return static_cast<ELEM>(item);
+		}
+	}
+
+protected: // data
+
+	std::span<const long> m_items;
+};
+
+/// Read-only view on a list of NUL separated UTF8 strings.
+/**
+ * This is the zero-copy variant of `std::vector<utf8_string>`, used for
+ * properties like _NET_DESKTOP_NAMES. Iterating over the view yields a
+ * std::string_view for each string. Splitting is bounded by the size of the
+ * property data, a missing terminator for the last string is tolerated.
+ *
+ * \warning The view is only valid as long as the Property object it has been
+ * obtained from is alive and unchanged.
+ **/
+template <>
+class PropertyView<utf8_string> {
+public: // types
+
+	using value_type = std::string_view;
+
+	/// Iterator yielding the individual strings.
+	class Iterator {
+	public: // types
+
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::string_view;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = std::string_view;
+
+	public: // functions
+
+		Iterator() = default;
+
+		Iterator(const char *pos, const char *end) :
+				m_pos{pos}, m_end{end} {
+			findNext();
+		}
+
+		std::string_view operator*() const { return m_cur; }
+
+		Iterator& operator++() {
+			m_pos += m_cur.size();
+			// skip the terminator, if present
+			if (m_pos != m_end)
+				++m_pos;
+			findNext();
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			auto ret = *this;
+			++(*this);
+			return ret;
+		}
+
+		bool operator==(const Iterator &other) const { return m_pos == other.m_pos; }
+		bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+	protected: // functions
+
+		void findNext() {
+			const auto left = static_cast<size_t>(m_end - m_pos);
+			// m_pos may be null for empty views, which memchr() doesn't allow
+			if (left == 0) {
+				m_cur = std::string_view{};
+				return;
+			}
+			auto term = static_cast<const char*>(std::memchr(m_pos, '\0', left));
+			m_cur = std::string_view{m_pos, term ? static_cast<size_t>(term - m_pos) : left};
+		}
+
+	protected: // data
+
+		const char *m_pos = nullptr;
+		const char *m_end = nullptr;
+		std::string_view m_cur;
+	};
+
+public: // functions
+
+	PropertyView() = default;
+
+	PropertyView(const char *data, const size_t bytes) :
+			m_data{data, bytes} {}
+
+	Iterator begin() const { return Iterator{m_data.data(), m_data.data() + m_data.size()}; }
+	Iterator end() const { return Iterator{m_data.data() + m_data.size(), m_data.data() + m_data.size()}; }
+
+	bool empty() const { return m_data.empty(); }
+
+	/// Returns the number of strings in the view.
+	/**
+	 * This needs to scan the complete data.
+	 **/
+	size_t count() const {
+		return std::distance(begin(), end());
+	}
+
+	/// Returns the complete raw data including separators.
+	std::string_view raw() const { return m_data; }
+
+protected: // data
+
+	std::string_view m_data;
+};
+
+/// property type specialization for zero-copy views on 32-bit list properties
+template <typename ELEM>
+class PropertyTraits<PropertyView<ELEM>> {
+public: // constants
+
+	static constexpr AtomID x_type = PropertyTraits<ELEM>::x_type;
+	static constexpr unsigned long FIXED_SIZE = 0;
+	static constexpr char FORMAT = 32;
+	using XPtrType = long*;
+
+	static_assert(PropertyTraits<ELEM>::FORMAT == 32, "PropertyView<ELEM> only supports 32-bit formats");
+
+public: // functions
+
+	static void x2native(PropertyView<ELEM> &v, XPtrType data, unsigned int count) {
+		v = PropertyView<ELEM>{data, count};
+	}
+};
+
+/// property type specialization for zero-copy views on UTF8 string lists
+template <>
+class PropertyTraits<PropertyView<utf8_string>> {
+public: // constants
+
+	static AtomID x_type;
+	static constexpr const CachedAtom *x_type_atom = PropertyTraits<utf8_string>::x_type_atom;
+	static constexpr unsigned long FIXED_SIZE = 0;
+	static constexpr char FORMAT = PropertyTraits<utf8_string>::FORMAT;
+	using XPtrType = const char*;
+
+public: // functions
+
+	static void init() {
+		x_type = PropertyTraits<utf8_string>::x_type;
+	}
+
+	static void x2native(PropertyView<utf8_string> &v, XPtrType data, unsigned int count) {
+		v = PropertyView<utf8_string>{data, count};
+	}
+};
+
+} // end ns
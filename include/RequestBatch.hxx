@@ -0,0 +1,121 @@
+#pragma once
+
+// C++
+#include <atomic>
+#include <limits>
+#include <optional>
+
+// X11
+#include <X11/Xlib.h>
+
+// cosmos
+#include <cosmos/utils.hxx>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/XDisplay.hxx>
+
+namespace xpp {
+
+/// RAII scope deferring implicit flushes of the output buffer.
+/**
+ * Operations like XWindow::setProperty(), XWindow::delProperty(),
+ * XWindow::sendEvent() or XWindow::destroy() flush the output buffer so
+ * that they take effect right away. Performing many of them in a row thus
+ * costs one socket write each.
+ *
+ * While a RequestBatch is active on an XDisplay, these implicit flushes are
+ * suppressed and the queued requests are sent out in a single flush when
+ * the batch ends:
+ *
+ *     {
+ *         RequestBatch batch;
+ *         for (auto &win: windows)
+ *             win.setProperty(atom, prop);
+ *     } // single flush here
+ *
+ * Batches can be nested, only the end of the outermost batch flushes.
+ * Explicit calls to XDisplay::flush() or XDisplay::sync() are not affected.
+ *
+ * If CheckErrors is set then finish() synchronizes with the X server and
+ * throws an X11Exception if any of the requests issued during the batch
+ * failed. Errors of requests like XChangeProperty are otherwise reported
+ * asynchronously to the Xlib error handler. While a checking batch is
+ * active, a custom Xlib error handler is installed that passes errors not
+ * belonging to a batch on to the previous handler. To learn about errors
+ * without synchronizing with the X server, see ErrorChannel.
+ *
+ * The batch depth is tracked per display, not per thread. A batch started
+ * in one thread also defers implicit flushes of other threads using the
+ * same display, like ConnectionThread does on its I/O thread. The depth
+ * is maintained atomically, thus batches may be started and finished
+ * concurrently from different threads.
+ **/
+class XPP_API RequestBatch {
+public: // types
+
+	using CheckErrors = cosmos::NamedBool<struct check_errors_t, false>;
+
+public: // functions
+
+	explicit RequestBatch(XDisplay &disp = xpp::display, const CheckErrors check = CheckErrors{false});
+
+	explicit RequestBatch(const CheckErrors check) :
+			RequestBatch{xpp::display, check} {}
+
+	/// Ends the batch if finish() has not been called yet.
+	/**
+	 * Errors occurring at this point can't be propagated, they're only
+	 * logged. Call finish() explicitly to receive them.
+	 **/
+	~RequestBatch();
+
+	RequestBatch(const RequestBatch&) = delete;
+	RequestBatch& operator=(const RequestBatch&) = delete;
+
+	/// Ends the batch.
+	/**
+	 * If this is the outermost batch then the output buffer is flushed.
+	 * If CheckErrors is set then the display is synchronized and an
+	 * X11Exception is thrown if any request issued during the batch
+	 * failed. Calling finish() again has no effect.
+	 **/
+	void finish();
+
+	/// Returns whether the batch is still active.
+	bool active() const { return !m_finished; }
+
+	/// Returns the number of X errors recorded for requests of this batch.
+	/**
+	 * Only available with CheckErrors set. Errors are only guaranteed to
+	 * be complete after finish() has been called.
+	 **/
+	size_t numErrors() const { return m_num_errors; }
+
+	/// Returns the first X error recorded for requests of this batch, if any.
+	const std::optional<XErrorEvent>& firstError() const { return m_first_error; }
+
+protected: // functions
+
+	void registerChecking();
+	void unregisterChecking();
+
+	/// Records `ev` if it belongs to a request of this batch.
+	bool recordError(Display *dis, const XErrorEvent &ev);
+
+protected: // data
+
+	XDisplay &m_display;
+	const bool m_check;
+	bool m_finished = false;
+	/// serial number of the first request issued during the batch.
+	unsigned long m_first_serial = 0;
+	/// serial number of the last request belonging to the batch, set in finish().
+	std::atomic<unsigned long> m_last_serial = std::numeric_limits<unsigned long>::max();
+	/// error sink registration while checking.
+	size_t m_sink = 0;
+	size_t m_num_errors = 0;
+	std::optional<XErrorEvent> m_first_error;
+};
+
+} // end ns
@@ -0,0 +1,51 @@
+#pragma once
+
+// xpp
+#include <xpp/XDisplay.hxx>
+
+namespace xpp {
+
+/// Identifies the X requests issued by a single wrapper call.
+/**
+ * Wrappers for requests that don't have a reply, like
+ * XWindow::setProperty(), return a token describing the serial number range
+ * of the requests they issued. Errors for such requests are only reported
+ * asynchronously. The token can be passed to an ErrorChannel to learn about
+ * the outcome without synchronizing with the X server.
+ *
+ * The token is a plain value and can be copied and discarded freely.
+ **/
+struct RequestToken {
+
+	RequestToken() = default;
+
+	/// Creates a token for all requests issued on `disp` starting at serial `first`.
+	RequestToken(XDisplay &disp, const unsigned long _first) :
+			display{&disp},
+			first{_first},
+			last{disp.nextRequest() - 1} {
+	}
+
+	/// Returns whether the token refers to a display at all.
+	bool valid() const { return display != nullptr; }
+
+	/// Returns whether no requests have been issued.
+	bool empty() const { return last < first; }
+
+	/// Returns whether the server processed all requests of this token.
+	/**
+	 * This does not perform any I/O. See XDisplay::lastProcessedRequest().
+	 **/
+	bool processed() const {
+		return empty() || display->lastProcessedRequest() >= last;
+	}
+
+	/// the display the requests were issued on.
+	XDisplay *display = nullptr;
+	/// serial number of the first request.
+	unsigned long first = 1;
+	/// serial number of the last request.
+	unsigned long last = 0;
+};
+
+} // end ns
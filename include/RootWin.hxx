@@ -1,6 +1,7 @@
 #pragma once
 
 // C++
+#include <unordered_map>
 #include <vector>
 
 // xpp
@@ -29,6 +30,9 @@ public: // types
 		}
 	};
 
+	/// Maps each window found in queryTree() to its parent window.
+	using ParentMap = std::unordered_map<WinID, WinID>;
+
 public: // functions
 
 	/// Creates a root window representation for the default display/screen.
@@ -54,6 +58,15 @@ public: // functions
 	 **/
 	const auto& windowTree() const { return m_tree; }
 
+	/// Returns the parent window of each window found in queryTree().
+	/**
+	 * Together with windowTree() this describes the complete window
+	 * hierarchy. The root window itself is not contained in this map.
+	 *
+	 * You need to call queryTree() to get actual data from this call.
+	 **/
+	const ParentMap& windowParents() const { return m_parents; }
+
 	/// Returns the list of active application main windows.
 	/**
 	 * You need to call queryWindows() to get actual data from this call.
@@ -66,6 +79,14 @@ public: // functions
 	/// Queries the complete window tree and stores the windows in the object.
 	/**
 	 * This includes also hidden and decoration windows.
+	 *
+	 * The tree is traversed breadth-first. The queries for all windows
+	 * of a tree level are sent out before waiting for any reply, thus the
+	 * number of round trips to the X server depends on the depth of the
+	 * tree, not on the number of windows.
+	 *
+	 * Windows that disappear while the query is running are silently
+	 * skipped.
 	 **/
 	void queryTree();
 
@@ -73,8 +94,10 @@ protected: // data
 
 	/// An array of all main windows existing, in undefined order.
 	std::vector<WinID> m_windows;
-	/// An array of all (even special) windows existing, in undefined order.
+	/// An array of all (even special) windows existing, in breadth-first order.
 	std::vector<WinID> m_tree;
+	/// The parent window of each window in m_tree.
+	ParentMap m_parents;
 };
 
 } // end ns
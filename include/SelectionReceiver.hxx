@@ -0,0 +1,112 @@
+#pragma once
+
+// C++
+#include <functional>
+#include <optional>
+#include <string_view>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/fwd.hxx>
+#include <xpp/types.hxx>
+#include <xpp/XWindow.hxx>
+
+namespace xpp {
+
+/// Retrieves selection data, supporting the ICCCM INCR protocol for large data.
+/**
+ * This is the counterpart of SelectionSender. After request() has been
+ * called the application needs to pass all events to processEvent(). The
+ * selection data is handed to a user supplied Sink function piece by piece,
+ * both for single-shot and incremental transfers. Property data is read
+ * via PropertyReader in bounded chunks, thus memory usage stays bounded
+ * regardless of the size of the transfer.
+ *
+ * Only a single transfer can be active at a time per receiver object.
+ *
+ * This type is not thread safe.
+ **/
+class XPP_API SelectionReceiver {
+public: // types
+
+	/// Function receiving the next piece of selection data.
+	using Sink = std::function<void (std::string_view data)>;
+
+	enum class State {
+		IDLE,     ///< no transfer was requested yet
+		WAITING,  ///< waiting for the selection owner to reply
+		INCR,     ///< an incremental transfer is in progress
+		DONE,     ///< the transfer has been completed
+		REFUSED   ///< the selection owner refused the conversion
+	};
+
+public: // functions
+
+	/// Creates a receiver storing transferred data in properties of `win`.
+	/**
+	 * `win` needs to stay valid for the lifetime of the receiver.
+	 *
+	 * \param[in] chunk_size The maximum number of bytes to read from a
+	 * property at once.
+	 **/
+	explicit SelectionReceiver(XWindow &win, const size_t chunk_size = 64 * 1024) :
+			m_win{win},
+			m_chunk_size{chunk_size}
+	{}
+
+	/// Restores the window's event selection if a transfer is still in progress.
+	~SelectionReceiver();
+
+	SelectionReceiver(const SelectionReceiver&) = delete;
+	SelectionReceiver& operator=(const SelectionReceiver&) = delete;
+
+	/// Requests conversion of `selection` into `target`.
+	/**
+	 * The data will be stored in `property` on the receiver window.
+	 * Any transfer still in progress is abandoned.
+	 **/
+	void request(const AtomID selection, const AtomID target, const AtomID property,
+			Sink sink, const XTime t = XTime::CURRENT_TIME);
+
+	/// Continues the transfer based on the given event.
+	/**
+	 * \return Whether the event belonged to the transfer.
+	 **/
+	bool processEvent(const Event &event);
+
+	State state() const { return m_state; }
+
+	/// Returns whether the transfer is finished, successfully or not.
+	bool finished() const { return m_state == State::DONE || m_state == State::REFUSED; }
+
+	/// The property type of the received data.
+	AtomID type() const { return m_type; }
+
+	/// The number of bytes passed to the sink so far.
+	size_t bytesReceived() const { return m_received; }
+
+protected: // functions
+
+	/// Passes the current property contents to the sink and deletes the property.
+	/**
+	 * \return The number of bytes read.
+	 **/
+	size_t consume();
+
+	/// Reverts the event selection changed by request(), if necessary.
+	void restoreEvents();
+
+protected: // data
+
+	XWindow &m_win;
+	const size_t m_chunk_size;
+	State m_state = State::IDLE;
+	AtomID m_property = AtomID::INVALID;
+	AtomID m_type = AtomID::INVALID;
+	Sink m_sink;
+	size_t m_received = 0;
+	/// the window's event selection before request() was called.
+	std::optional<EventSelectionMask> m_prev_events;
+};
+
+} // end ns
@@ -0,0 +1,141 @@
+#pragma once
+
+// C++
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/fwd.hxx>
+#include <xpp/types.hxx>
+
+namespace xpp {
+
+/// Serves selection requests, using the ICCCM INCR protocol for large data.
+/**
+ * A selection owner answers a SelectionRequest by storing the data in a
+ * property of the requestor window. A single property change request cannot
+ * exceed the maximum request size of the X server, see
+ * XDisplay::maxRequestSize(). For larger data ICCCM defines the INCR
+ * protocol, where the owner writes the data chunk by chunk, each time the
+ * requestor deleted the previous chunk.
+ *
+ * This type takes care of both, single-shot and incremental transfers. The
+ * data is pulled from a user supplied Source function on demand, thus only
+ * a single chunk per transfer is kept in memory. Multiple transfers to
+ * different requestors can be active at the same time.
+ *
+ * The application needs to pass all events to processEvent() to drive
+ * incremental transfers. Data is always transferred in 8-bit format.
+ *
+ * This type is not thread safe.
+ **/
+class XPP_API SelectionSender {
+public: // types
+
+	/// Function providing the next piece of data to transfer.
+	/**
+	 * The function needs to store up to `max` bytes in `buf` and return
+	 * the number of bytes stored. Returning zero signals the end of the
+	 * data.
+	 **/
+	using Source = std::function<size_t (char *buf, size_t max)>;
+
+public: // functions
+
+	/// Creates a sender transferring at most `chunk_size` bytes per request.
+	/**
+	 * If `chunk_size` is zero then a size suitable for the X server's
+	 * maximum request size is chosen. Requests are served on the given
+	 * display.
+	 **/
+	explicit SelectionSender(const size_t chunk_size = 0, XDisplay &disp = xpp::display);
+
+	/// Aborts any incremental transfers still in progress.
+	~SelectionSender();
+
+	SelectionSender(const SelectionSender&) = delete;
+	SelectionSender& operator=(const SelectionSender&) = delete;
+
+	/// Answers the given selection request with data from `source`.
+	/**
+	 * `type` is the property type the data is stored with, e.g. the
+	 * target type or UTF8_STRING.
+	 *
+	 * If the data fits into a single chunk then it is written right away
+	 * and the transfer is complete. Otherwise an incremental transfer is
+	 * started and continued in processEvent().
+	 *
+	 * \param[in] size_hint The total size of the data, if known. This is
+	 * announced to the requestor in the INCR property.
+	 **/
+	void serve(const SelectionRequestEvent &request, const AtomID type,
+			Source source, const std::optional<size_t> size_hint = std::nullopt);
+
+	/// Refuses the given selection request.
+	void refuse(const SelectionRequestEvent &request);
+
+	/// Continues incremental transfers based on the given event.
+	/**
+	 * \return Whether the event belonged to an active transfer.
+	 **/
+	bool processEvent(const Event &event);
+
+	/// Returns the number of incremental transfers still in progress.
+	size_t activeTransfers() const { return m_transfers.size(); }
+
+	size_t chunkSize() const { return m_chunk_size; }
+
+protected: // types
+
+	struct Transfer {
+		AtomID type;
+		Source source;
+		/// the next chunk to write.
+		std::string chunk;
+		/// whether the source signaled the end of data.
+		bool eof = false;
+		/// a byte read ahead from the source, see probeEOF().
+		std::optional<char> lookahead;
+	};
+
+	/// transfers are identified by the requestor window and property.
+	using Key = std::pair<WinID, AtomID>;
+
+protected: // functions
+
+	/// Fills `transfer.chunk` with up to one chunk of data from the source.
+	void readChunk(Transfer &transfer);
+
+	/// Checks whether the source is exhausted after a full chunk.
+	/**
+	 * A source delivering exactly one chunk of data only reports EOF on
+	 * the next read. This reads ahead a single byte to find out, which is
+	 * kept in `transfer.lookahead` for the next chunk.
+	 **/
+	void probeEOF(Transfer &transfer);
+
+	/// Writes the current chunk, or the final zero-length chunk.
+	void writeChunk(const Key &key, Transfer &transfer);
+
+	/// Restores the requestor's event selection if no transfers to it are left.
+	void finishRequestor(const WinID requestor);
+
+	void notify(const SelectionRequestEvent &request, const AtomID property);
+
+	void changeProperty(const WinID win, const AtomID property, const AtomID type,
+			const int format, const void *data, const size_t items);
+
+protected: // data
+
+	XDisplay *m_display = nullptr;
+	size_t m_chunk_size = 0;
+	std::map<Key, Transfer> m_transfers;
+	/// the event selection of requestor windows before transfers to them started.
+	std::map<WinID, EventSelectionMask> m_requestors;
+};
+
+} // end ns
@@ -0,0 +1,147 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+// X11
+#include <X11/Xatom.h>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/PropertyTraits.hxx>
+#include <xpp/types.hxx>
+
+namespace xpp {
+
+/// Narrows 32-bit format property items into packed 32-bit values.
+/**
+ * Xlib stores 32-bit format property data in arrays of `long`, which is 64
+ * bits wide on 64-bit platforms. This copies the lower 32 bits of `count`
+ * items from `data` into `out`, which needs to provide room for `count`
+ * items.
+ *
+ * On x86 this processes 4 (SSE2) or 8 (AVX2) items at once, the
+ * implementation is selected at runtime.
+ **/
+XPP_API void narrow_format32(const long *data, const size_t count, uint32_t *out);
+
+/// A set of ARGB images as found in the _NET_WM_ICON property.
+/**
+ * The EWMH property consists of an arbitrary number of images, each
+ * prefixed by its width and height, stored as 32-bit CARDINAL items. Each
+ * pixel is a non-premultiplied ARGB value, rows are stored top to bottom.
+ *
+ * The pixels of all images are kept in a single packed buffer of 32-bit
+ * values, which takes half the memory of the `long` array Xlib returns on
+ * 64-bit platforms. When a target size is passed to parse() only the icon
+ * best suited for it is kept, downscaled to fit it if necessary.
+ **/
+class XPP_API WindowIcons {
+public: // types
+
+	/// A single icon image.
+	struct Icon {
+		Extent extent;
+		/// `extent.width * extent.height` ARGB pixels in row-major order
+		std::span<const uint32_t> pixels;
+	};
+
+public: // functions
+
+	WindowIcons() = default;
+
+	/// Parses raw _NET_WM_ICON data as delivered by Xlib.
+	/**
+	 * `data` contains `count` 32-bit items stored in `long`. Icons with a
+	 * zero dimension are skipped, a truncated trailing icon is ignored.
+	 *
+	 * If `size` is given then only the smallest icon covering `size` is
+	 * kept, or the largest icon if none of them covers it. If the selected
+	 * icon is larger than `size` in any dimension then it is downscaled
+	 * to fit into `size`, keeping its aspect ratio.
+	 **/
+	void parse(const long *data, const size_t count, const std::optional<Extent> size = {});
+
+	/// Removes all icons.
+	void clear() {
+		m_entries.clear();
+		m_pixels.clear();
+	}
+
+	/// Returns the number of icons.
+	size_t size() const { return m_entries.size(); }
+
+	bool empty() const { return m_entries.empty(); }
+
+	/// Returns the icon at the given index.
+	Icon operator[](const size_t index) const {
+		const auto &entry = m_entries[index];
+		return Icon{entry.extent, std::span{m_pixels}.subspan(entry.offset, numPixels(entry.extent))};
+	}
+
+	/// Like operator[] but with bounds checking.
+	Icon at(const size_t index) const;
+
+	/// Returns the smallest icon covering `size`, or the largest one if there is none.
+	/**
+	 * If no icons are present then nothing is returned.
+	 **/
+	std::optional<Icon> best(const Extent size) const;
+
+	/// Returns the number of bytes used for the pixel data of all icons.
+	size_t pixelBytes() const { return m_pixels.size() * sizeof(uint32_t); }
+
+protected: // types
+
+	/// Location of a single icon in m_pixels.
+	struct Entry {
+		Extent extent;
+		size_t offset = 0;
+	};
+
+protected: // functions
+
+	static size_t numPixels(const Extent extent) {
+		return size_t{extent.width} * extent.height;
+	}
+
+	/// Returns the index into `entries` of the best icon for `size`.
+	static size_t selectBest(const std::vector<Entry> &entries, const Extent size);
+
+	/// Downscales `src` of `src_extent` into `dst` of `dst_extent`.
+	static void downscale(const uint32_t *src, const Extent src_extent,
+			uint32_t *dst, const Extent dst_extent);
+
+protected: // data
+
+	std::vector<Entry> m_entries;
+	/// the pixel data of all icons
+	std::vector<uint32_t> m_pixels;
+};
+
+/// property type specialization for parsing _NET_WM_ICON data
+/**
+ * This allows to retrieve all icons via `Property<WindowIcons>`. The
+ * parsed icons are independent of the Property object. To downscale icons
+ * on retrieval use XWindow::getIcons().
+ **/
+template <>
+class PropertyTraits<WindowIcons> {
+public: // constants
+
+	static constexpr AtomID x_type = AtomID{XA_CARDINAL};
+	static constexpr unsigned long FIXED_SIZE = 0;
+	static constexpr char FORMAT = 32;
+	using XPtrType = long*;
+
+public: // functions
+
+	static void x2native(WindowIcons &icons, XPtrType data, unsigned int count) {
+		icons.parse(data, count);
+	}
+};
+
+} // end ns
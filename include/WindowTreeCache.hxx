@@ -0,0 +1,191 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+// cosmos
+#include <cosmos/utils.hxx>
+
+// xpp
+#include <xpp/dso_export.h>
+#include <xpp/fwd.hxx>
+#include <xpp/RootWin.hxx>
+#include <xpp/types.hxx>
+#include <xpp/XWindow.hxx>
+
+namespace xpp {
+
+/// A local copy of the window hierarchy that is kept up to date via events.
+/**
+ * RootWin::queryTree() needs to query the complete window hierarchy from the
+ * X server each time it is called. This type queries the hierarchy only once
+ * in seed() and then keeps it up to date by processing CreateNotify,
+ * DestroyNotify, ReparentNotify, MapNotify and UnmapNotify events passed to
+ * processEvent(). Lookups of parent, children and mapped state of windows
+ * thus don't need any communication with the X server.
+ *
+ * To receive the necessary events, SubstructureNotify needs to be selected
+ * on every window in the hierarchy. seed() can do this automatically, also
+ * for windows created later on. Since X11 event masks are per-client and
+ * per-window, SubstructureNotify is merged into the event mask this client
+ * already selected on each window. For windows created later on, the
+ * current mask is only looked up if this client created the window itself.
+ * Events selected by this client on a foreign window between its creation
+ * and the processing of its CreateNotify event are lost.
+ *
+ * Creation and destruction of windows can race with the selection of events
+ * on them. Use verify() or setVerifyInterval() to check the cache against the
+ * actual state on the X server.
+ *
+ * This type is not thread safe.
+ **/
+class XPP_API WindowTreeCache {
+public: // types
+
+	/// Whether seed() should select the necessary events on all windows.
+	using SelectEvents = cosmos::NamedBool<struct select_events_t, true>;
+
+	/// Cached state of a single window.
+	struct Node {
+		/// the parent window, WinID::INVALID for the root window.
+		WinID parent = WinID::INVALID;
+		/// the direct child windows.
+		XWindow::WindowSet children;
+		/// whether the window is currently mapped.
+		bool mapped = false;
+	};
+
+public: // functions
+
+	/// Creates an empty cache for the hierarchy below `root`.
+	/**
+	 * The `root` object needs to stay valid for the lifetime of the
+	 * cache.
+	 **/
+	explicit WindowTreeCache(RootWin &root) :
+			m_root{root}
+	{}
+
+	/// Queries the complete window hierarchy from the X server.
+	/**
+	 * Any previously cached state is discarded.
+	 **/
+	void seed(const SelectEvents select = SelectEvents{true});
+
+	/// Updates the cache based on the given event.
+	/**
+	 * Events not relevant for the window hierarchy are ignored.
+	 *
+	 * \return Whether the event was relevant for the cache.
+	 **/
+	bool processEvent(const Event &event);
+
+	/// Returns whether the given window is known.
+	bool contains(const WinID win) const {
+		return m_nodes.find(win) != m_nodes.end();
+	}
+
+	/// Returns the cached state of the given window, if known.
+	const Node* node(const WinID win) const {
+		auto it = m_nodes.find(win);
+		return it == m_nodes.end() ? nullptr : &it->second;
+	}
+
+	/// Returns the parent of the given window, if known.
+	std::optional<WinID> parent(const WinID win) const {
+		if (auto n = node(win); n && n->parent != WinID::INVALID)
+			return n->parent;
+		return std::nullopt;
+	}
+
+	/// Returns the children of the given window, an empty set if unknown.
+	const XWindow::WindowSet& children(const WinID win) const {
+		if (auto n = node(win); n)
+			return n->children;
+		return m_no_children;
+	}
+
+	/// Returns whether the given window is known and mapped.
+	bool isMapped(const WinID win) const {
+		auto n = node(win);
+		return n && n->mapped;
+	}
+
+	/// Returns the number of windows in the cache, including the root window.
+	size_t size() const { return m_nodes.size(); }
+
+	/// Compares the cached state against a fresh query of the X server.
+	/**
+	 * This is an expensive operation that is meant for testing the
+	 * reliability of the cache. Any differences found are logged as
+	 * warnings via the libxpp logger.
+	 *
+	 * \return The number of windows for which differences have been
+	 * found.
+	 **/
+	size_t verify();
+
+	/// Automatically call verify() after every `events` relevant events.
+	/**
+	 * A value of zero disables automatic verification, which is the
+	 * default.
+	 **/
+	void setVerifyInterval(const size_t events) {
+		m_verify_interval = events;
+		m_events_since_verify = 0;
+	}
+
+protected: // types
+
+	using NodeMap = std::unordered_map<WinID, Node>;
+
+protected: // functions
+
+	/// Event masks this client selected on windows, as raw values.
+	using EventMaskMap = std::unordered_map<WinID, uint32_t>;
+
+	/// Queries the complete hierarchy including mapped state into `nodes`.
+	/**
+	 * If `event_masks` is passed then it receives this client's current
+	 * event mask for each window.
+	 **/
+	void query(NodeMap &nodes, EventMaskMap *event_masks);
+
+	/// Adds `win` below `parent`, if the parent is known.
+	/**
+	 * \return Whether the window has been added.
+	 **/
+	bool addWindow(const WinID win, const WinID parent, const bool mapped);
+
+	void removeWindow(const WinID win);
+
+	/// Moves the known window `win` below `parent`.
+	/**
+	 * If `parent` is unknown then the window left the tracked tree and
+	 * is removed.
+	 **/
+	void setParent(const WinID win, const WinID parent);
+
+	/// Updates the mapped state of `win`, if it is known.
+	void setMapped(const WinID win, const bool mapped);
+
+	/// Returns the event mask this client selected on the newly created `win`.
+	uint32_t ownEventMask(const WinID win);
+
+	/// Adds SubstructureNotify to the `current` event mask of `win`.
+	void selectEvents(const WinID win, const uint32_t current);
+
+protected: // data
+
+	RootWin &m_root;
+	NodeMap m_nodes;
+	bool m_select_events = false;
+	size_t m_verify_interval = 0;
+	size_t m_events_since_verify = 0;
+	const XWindow::WindowSet m_no_children;
+};
+
+} // end ns
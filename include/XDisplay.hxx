@@ -4,7 +4,10 @@
 #include <stdint.h>
 
 // C++
+#include <atomic>
+#include <memory>
 #include <optional>
+#include <vector>
 
 // X11
 #include <X11/Xlib.h>
@@ -14,6 +17,7 @@
 #include <cosmos/SysString.hxx>
 
 // xpp
+#include <xpp/AtomMapper.hxx>
 #include <xpp/helpers.hxx>
 #include <xpp/fwd.hxx>
 #include <xpp/types.hxx>
@@ -21,6 +25,11 @@
 
 namespace xpp {
 
+namespace instr {
+	struct DisplayCounters;
+	DisplayCounters& counters_for(const XDisplay &disp);
+}
+
 /// Wrapper around the Xlib Display type.
 /**
  * This class associates the Xlib Display type with relevant operations. Most
@@ -30,10 +39,11 @@ namespace xpp {
  * A global xpp::display instance allows simple access to the default display
  * which is opened based on environment variables.
  *
- * Making it possible to operate on the non-default Display should be not
- * too hard to implement in the future, if every needed. The xpp::display
- * could e.g. be constructed differently based on xpp library initialization
- * parameters.
+ * Further displays can be opened by name. Each display owns its own
+ * AtomMapper, since atom IDs are only valid on the X server they have been
+ * obtained from. Types like XWindow, Pixmap or GraphicsContext keep a
+ * reference to the display they belong to, thus a single process can
+ * operate on multiple X servers at the same time.
  **/
 class XPP_API XDisplay {
 public: // types
@@ -48,7 +58,7 @@ public: // types
 	/// Specialized Exception for errors regarding opening the Display.
 	struct DisplayOpenError :
 			public cosmos::CosmosError {
-		DisplayOpenError();
+		explicit DisplayOpenError(const char *name = nullptr);
 	};
 
 	using Initialize = cosmos::NamedBool<struct init_t, true>;
@@ -62,15 +72,15 @@ public: // functions
 	 **/
 	XDisplay(const Initialize init = Initialize{true});
 
+	/// Opens the display of the given name like ":1" or "host:0.1".
+	explicit XDisplay(const cosmos::SysString name);
+
 	XDisplay(XDisplay &&other) noexcept {
 		*this = std::move(other);
 	}
 
-	XDisplay& operator=(XDisplay &&other) noexcept {
-		m_dis = other.m_dis;
-		other.m_dis = nullptr;
-		return *this;
-	}
+	/// Takes over the connection of `other`, closing the current one, if any.
+	XDisplay& operator=(XDisplay &&other) noexcept;
 
 	/// Closes the display handle again
 	~XDisplay();
@@ -95,6 +105,21 @@ public: // functions
 		return getPendingEvents() != 0;
 	}
 
+	/// Returns the number of events queued, according to `mode`.
+	/**
+	 * In contrast to getPendingEvents() this allows to check the local
+	 * event queue without flushing the output buffer or without
+	 * performing any I/O at all. This call never blocks.
+	 **/
+	size_t eventsQueued(const QueueMode mode) const {
+		auto ret = ::XEventsQueued(m_dis, cosmos::to_integral(mode));
+		if (ret < 0) {
+			cosmos_throw (X11Exception("XEventsQueued() failed"));
+		}
+
+		return static_cast<size_t>(ret);
+	}
+
  	/// Creates an X atom for the given string and returns it.
 	/**
 	 * The function always returns a valid atom, even if it first needs to
@@ -102,21 +127,29 @@ public: // functions
 	 *
 	 * Can throw AtomMappingError.
 	 **/
-	AtomID mapAtom(const cosmos::SysString name) {
-		auto ret = ::XInternAtom(m_dis, name.raw(), False);
+	AtomID mapAtom(const cosmos::SysString name);
 
-		if (ret == BadAlloc || ret == BadValue || ret == None) {
-			cosmos_throw (AtomMappingError(m_dis, ret, name));
-		}
+	/// Creates X atoms for all of the given strings using a single round trip.
+	/**
+	 * This is the bulk version of mapAtom(). The resulting atoms will be
+	 * stored in `atoms` in the same order as found in `names`.
+	 *
+	 * Can throw AtomMappingError.
+	 **/
+	void mapAtoms(const std::vector<cosmos::SysString> &names, AtomIDVector &atoms);
 
-		return AtomID{ret};
-	}
+	std::string mapName(const AtomID atom);
 
-	std::string mapName(const AtomID atom) {
-		auto str = ::XGetAtomName(m_dis, raw_atom(atom));
-		std::string ret{str};
-		::XFree(str);
-		return ret;
+	/// Returns the atom cache for this display.
+	/**
+	 * For the default xpp::display this is the global xpp::atom_mapper.
+	 * Other displays allocate their own AtomMapper on first use.
+	 **/
+	AtomMapper& atomMapper();
+
+	/// Returns the root window ID of the given screen.
+	WinID rootWindow(const std::optional<ScreenID> screen = std::nullopt) const {
+		return WinID{::XRootWindow(m_dis, raw_screen(screen ? *screen : defaultScreen()))};
 	}
 
 	/// Flushes any commands not yet issued to the server.
@@ -129,12 +162,33 @@ public: // functions
 	 * To make sure that any recently issued communication to the X server
 	 * takes place right now you can call this function.
 	 **/
-	void flush() {
-		if (::XFlush(m_dis) == 0) {
-			cosmos_throw (X11Exception("XFlush failed"));
+	void flush();
+
+	/// Flushes unless a RequestBatch is active on this display.
+	/**
+	 * libxpp calls this after operations that are expected to take effect
+	 * right away, like XWindow::setProperty(). Within a RequestBatch
+	 * scope the flush is deferred to the end of the outermost batch.
+	 **/
+	void autoFlush() {
+		if (m_batch_depth == 0) {
+			flush();
 		}
 	}
 
+	/// Returns whether a RequestBatch is currently active on this display.
+	bool isBatching() const { return m_batch_depth != 0; }
+
+	/// Returns the serial number the next request on this display will receive.
+	unsigned long nextRequest() const { return ::XNextRequest(m_dis); }
+
+	/// Returns the serial number of the last request known to be processed by the server.
+	/**
+	 * This does not perform any I/O. The value advances whenever a reply,
+	 * event or error is read from the connection.
+	 **/
+	unsigned long lastProcessedRequest() const { return ::XLastKnownRequestProcessed(m_dis); }
+
 	/// Returns the next event pending for this client.
 	/**
 	 * If no event is currently queued at the display then output buffers
@@ -148,6 +202,15 @@ public: // functions
 	 **/
 	void nextEvent(Event &event);
 
+	/// Records all events returned from nextEvent() into `recorder`.
+	/**
+	 * Passing `nullptr` stops recording. The recorder needs to stay valid
+	 * while it is set.
+	 **/
+	void setEventRecorder(EventRecorder *recorder) {
+		m_recorder = recorder;
+	}
+
 	/// Returns whether the given event was received on this display.
 	bool sameDisplay(const AnyEvent &event);
 
@@ -189,11 +252,7 @@ public: // functions
 	 * events to be notified of and want to make sure the XServer knows
 	 * this at some point in time.
 	 **/
-	void sync() {
-		if (::XSync(m_dis, False) == 0) {
-			cosmos_throw (X11Exception("XSync failed"));
-		}
-	}
+	void sync();
 
 	/// puts libX11 into synchronized or unsynchronized mode.
 	/**
@@ -210,6 +269,20 @@ public: // functions
 	 **/
 	void setSynchronized(bool on_off);
 
+	/// Returns the maximum size of a single request in bytes.
+	/**
+	 * This considers the BIG-REQUESTS extension, if available. Requests
+	 * transferring data, like changing a property, need to stay below
+	 * this limit.
+	 **/
+	size_t maxRequestSize() const {
+		auto units = ::XExtendedMaxRequestSize(m_dis);
+		if (units == 0)
+			units = ::XMaxRequestSize(m_dis);
+		// the limit is specified in 4-byte units
+		return static_cast<size_t>(units) * 4;
+	}
+
 	ScreenID defaultScreen() const {
 		return ScreenID{::XDefaultScreen(m_dis)};
 	}
@@ -253,6 +326,16 @@ public: // functions
 
 protected: // functions
 
+	friend class RequestBatch;
+	friend class Xpp;
+	friend instr::DisplayCounters& instr::counters_for(const XDisplay &disp);
+
+	/// Opens the display of the given name, or the default one for nullptr.
+	void open(const char *name);
+
+	/// Closes the connection, if any.
+	void close();
+
 	// disallow copying since the class has ownership semantics
 	XDisplay(const XDisplay &other) = delete;
 	XDisplay& operator=(const XDisplay &other) = delete;
@@ -261,6 +344,14 @@ protected: // data
 
 	/// The Xlib primitive for the Display
 	mutable Display *m_dis = nullptr;
+	/// optional recorder for events returned from nextEvent().
+	EventRecorder *m_recorder = nullptr;
+	/// nesting level of active RequestBatch scopes, possibly from different threads.
+	std::atomic<size_t> m_batch_depth = 0;
+	/// the atom cache of this display, allocated on demand, unused for the default display.
+	std::atomic<AtomMapper*> m_atom_mapper = nullptr;
+	/// cached protocol counters, only used with XPP_INSTRUMENT.
+	mutable std::atomic<instr::DisplayCounters*> m_instr_counters = nullptr;
 };
 
 /// An instance to access the default display
@@ -2,6 +2,7 @@
 
 // C++
 #include <memory>
+#include <optional>
 #include <set>
 #include <string_view>
 #include <utility>
@@ -17,7 +18,11 @@
 // xpp
 #include <xpp/dso_export.h>
 #include <xpp/fwd.hxx>
+#include <xpp/CachedAtom.hxx>
 #include <xpp/ClassHints.hxx>
+#include <xpp/PropertyKey.hxx>
+#include <xpp/PropertyResult.hxx>
+#include <xpp/RequestToken.hxx>
 #include <xpp/types.hxx>
 #include <xpp/utf8_string.hxx>
 #include <xpp/X11Exception.hxx>
@@ -29,6 +34,10 @@ namespace xpp {
 /**
  * This class stores an XWindow identifier and provides operations on X Window
  * objects, like retrieving and setting window properties.
+ *
+ * Each object is bound to the XDisplay the window belongs to, by default
+ * this is the global xpp::display. All operations are carried out on this
+ * display.
  **/
 class XPP_API XWindow {
 public: // types
@@ -51,6 +60,12 @@ public: // types
 	struct PropertyTypeMismatch :
 			public cosmos::CosmosError {
 		PropertyTypeMismatch(AtomID expected, AtomID encountered,
+				const cosmos::SourceLocation &loc = cosmos::SourceLocation::current()) :
+				PropertyTypeMismatch{xpp::display, expected, encountered, loc} {
+		}
+
+		/// Uses the atom names from the given display for the error message.
+		PropertyTypeMismatch(XDisplay &disp, AtomID expected, AtomID encountered,
 				const cosmos::SourceLocation &loc = cosmos::SourceLocation::current());
 	};
 
@@ -95,14 +110,18 @@ public: // functions
 	/// Plain copy
 	XWindow(const XWindow &other) = default;
 
-	/// Create an object representing `win` on the default Display
-	explicit XWindow(WinID win);
+	/// Create an object representing `win` on the given Display
+	explicit XWindow(WinID win, XDisplay &disp = xpp::display);
 
+	/// Assigns a new window ID on the same display.
 	XWindow& operator=(const WinID &win) {
-		*this = XWindow{win};
+		*this = XWindow{win, *m_display};
 		return *this;
 	}
 
+	/// Returns the display this window belongs to.
+	XDisplay& getDisplay() const { return *m_display; }
+
 	/// returns whether the object is bound to window
 	bool valid() const { return m_win != WinID::INVALID; }
 
@@ -122,6 +141,13 @@ public: // functions
 	 **/
 	std::string getName() const;
 
+	/// Non-throwing variant of getName().
+	/**
+	 * The status of the ICCCM fallback is reported if neither property
+	 * can be retrieved.
+	 **/
+	PropertyResult<std::string> tryGetName() const;
+
 	/// Set `name` as the new name of the current window.
 	/**
 	 * If the window name cannot be set then an exception is thrown.
@@ -139,6 +165,9 @@ public: // functions
 	 **/
 	cosmos::ProcessID getPID() const;
 
+	/// Non-throwing variant of getPID().
+	PropertyResult<cosmos::ProcessID> tryGetPID() const;
+
 	/// Retrieve the desktop number the window is currently on.
 	/**
 	 * The same details found at getName() are true here, too.
@@ -147,9 +176,15 @@ public: // functions
 	 **/
 	int getDesktop() const;
 
+	/// Non-throwing variant of getDesktop().
+	PropertyResult<int> tryGetDesktop() const;
+
 	/// returns the client machine the window is associated with.
 	std::string getClientMachine() const;
 
+	/// Non-throwing variant of getClientMachine().
+	PropertyResult<std::string> tryGetClientMachine() const;
+
 	/// Returns the window class parameters for this window.
 	/**
 	 * The first returned string is the name of the application, the
@@ -159,12 +194,21 @@ public: // functions
 	 **/
 	ClassStringPair getClass() const;
 
+	/// Non-throwing variant of getClass().
+	PropertyResult<ClassStringPair> tryGetClass() const;
+
 	/// Returns the command line used to create the window.
 	std::string getCommand() const;
 
+	/// Non-throwing variant of getCommand().
+	PropertyResult<std::string> tryGetCommand() const;
+
 	/// Returns the locale used by the window.
 	std::string getLocale() const;
 
+	/// Non-throwing variant of getLocale().
+	PropertyResult<std::string> tryGetLocale() const;
+
 	/// Returns the ID of the client leader window.
 	/**
 	 * The client leader is part of the window manager session management
@@ -175,6 +219,9 @@ public: // functions
 	 **/
 	WinID getClientLeader() const;
 
+	/// Non-throwing variant of getClientLeader().
+	PropertyResult<WinID> tryGetClientLeader() const;
+
 	/// Returns the type of the window.
 	/**
 	 * The returned value is an atom of a predefined set of values like
@@ -182,6 +229,22 @@ public: // functions
 	 **/
 	AtomID getWindowType() const;
 
+	/// Non-throwing variant of getWindowType().
+	PropertyResult<AtomID> tryGetWindowType() const;
+
+	/// Retrieves the ARGB icon images of the window.
+	/**
+	 * The icons are parsed from the _NET_WM_ICON property. If `size` is
+	 * given then only the icon best suited for this size is kept,
+	 * downscaled if it is larger, see WindowIcons::parse().
+	 *
+	 * On error an exception is thrown.
+	 **/
+	void getIcons(WindowIcons &icons, const std::optional<Extent> size = {}) const;
+
+	/// Non-throwing variant of getIcons().
+	PropertyStatus tryGetIcons(WindowIcons &icons, const std::optional<Extent> size = {}) const;
+
 	/// Returns the array of atoms representing the protocols supported by the window.
 	void getProtocols(AtomIDVector &protocols) const;
 
@@ -189,7 +252,7 @@ public: // functions
 	/**
 	 * This can throw an exception on error.
 	 **/
-	void setProtocols(const AtomIDVector &protocols);
+	RequestToken setProtocols(const AtomIDVector &protocols);
 
 	/// returns the currently set XWMHints for the window.
 	/**
@@ -198,13 +261,13 @@ public: // functions
 	 **/
 	std::shared_ptr<WindowManagerHints> getWMHints() const;
 
-	void setWMHints(const WindowManagerHints &hints);
+	RequestToken setWMHints(const WindowManagerHints &hints);
 
 	/// Sets new window class and name hints for the window.
-	void setClassHints(const ClassHints hints);
+	RequestToken setClassHints(const ClassHints hints);
 
 	/// Sets normal window manager size hints for the window.
-	void setWMNormalHints(const SizeHints &hints);
+	RequestToken setWMNormalHints(const SizeHints &hints);
 
 	/// Requests the X server to destroy the represented window and all sub-windows.
 	/**
@@ -217,7 +280,7 @@ public: // functions
 	 * successful return from this function. Further operations on it will
 	 * fail.
 	 **/
-	void destroy();
+	RequestToken destroy();
 
 	/// Creates a pseudo window as child of the current window.
 	/**
@@ -241,7 +304,7 @@ public: // functions
 	 * \param[in] target_prop
 	 * 	The target property the selection should be copied to
 	 **/
-	void convertSelection(
+	RequestToken convertSelection(
 		const AtomID selection,
 		const AtomID target_type,
 		const AtomID target_prop,
@@ -253,7 +316,7 @@ public: // functions
 	 * This means that other clients on the XServer can in the future
 	 * request the selection from this window.
 	 **/
-	void makeSelectionOwner(const AtomID selection, const XTime t = XTime::CURRENT_TIME);
+	RequestToken makeSelectionOwner(const AtomID selection, const XTime t = XTime::CURRENT_TIME);
 
 	/// Requests the targeted window to close itself.
 	/**
@@ -279,6 +342,13 @@ public: // functions
 	 **/
 	void getPropertyInfo(const AtomID property, PropertyInfo &info);
 
+	/// Non-throwing variant of getPropertyInfo().
+	/**
+	 * \return PropertyStatus::NOT_EXISTING if the property is not
+	 * present, PropertyStatus::QUERY_ERROR on X errors.
+	 **/
+	PropertyStatus tryGetPropertyInfo(const AtomID property, PropertyInfo &info);
+
 	/// Retrieves raw property data without interpreting type and format.
 	/**
 	 * Similar to getPropertyInfo() this returns the actual property info
@@ -292,6 +362,14 @@ public: // functions
 	 **/
 	void getRawProperty(const AtomID property, PropertyInfo &info, RawProperty &out);
 
+	/// Non-throwing variant of getRawProperty().
+	/**
+	 * X errors and missing properties are reported via the return value
+	 * like in tryGetPropertyInfo(). Misaligned lengths or offsets are
+	 * usage errors and still cause an exception.
+	 **/
+	PropertyStatus tryGetRawProperty(const AtomID property, PropertyInfo &info, RawProperty &out);
+
 	/// Retrieve a property for this window object by name.
 	/**
 	 * The property `name` will be queried from the current window and
@@ -300,10 +378,32 @@ public: // functions
 	 * On error an exception is thrown.
 	 *
 	 * The PROPTYPE type must match the property's type.
+	 *
+	 * The atom for `name` is looked up via the display's AtomMapper, thus
+	 * only the first lookup of a name costs a round trip.
 	 **/
 	template <typename PROPTYPE>
 	void getProperty(const cosmos::SysString name, Property<PROPTYPE> &p) const {
-		getProperty(display.mapAtom(name), p);
+		getProperty(m_display->atomMapper().mapAtom(name.view()), p);
+	}
+
+	/// Retrieve a property for this window object by PropertyKey.
+	/**
+	 * The property's C++ type is checked against the key at compile
+	 * time, the atom is resolved once per display.
+	 **/
+	template <fixed_string NAME, typename PROPTYPE>
+	void getProperty(const PropertyKey<NAME, PROPTYPE> key, Property<PROPTYPE> &p, const PropertyInfo *info = nullptr) const {
+		getProperty(key.atomFor(*m_display), p, info);
+	}
+
+	/// Retrieve a property for this window object by CachedAtom.
+	/**
+	 * The atom is resolved for the display of this window.
+	 **/
+	template <typename PROPTYPE>
+	void getProperty(const CachedAtom &atom, Property<PROPTYPE> &p, const PropertyInfo *info = nullptr) const {
+		getProperty(atom.atom(*m_display), p, info);
 	}
 
 	/// Gets a property for this window object by AtomID.
@@ -316,16 +416,61 @@ public: // functions
 	template <typename PROPTYPE>
 	void getProperty(const AtomID name_atom, Property<PROPTYPE> &p, const PropertyInfo *info = nullptr) const;
 
+	/// Non-throwing variant of getProperty().
+	/**
+	 * Conditions that are normal when scanning arbitrary windows, like
+	 * missing properties or properties of an unexpected type, are
+	 * reported via the return value instead of an exception. This avoids
+	 * the cost of exception unwinding and error message formatting. `p`
+	 * is only modified if PropertyStatus::OK is returned.
+	 **/
+	template <typename PROPTYPE>
+	PropertyStatus tryGetProperty(const AtomID name_atom, Property<PROPTYPE> &p, const PropertyInfo *info = nullptr) const;
+
+	template <typename PROPTYPE>
+	PropertyStatus tryGetProperty(const CachedAtom &atom, Property<PROPTYPE> &p, const PropertyInfo *info = nullptr) const {
+		return tryGetProperty(atom.atom(*m_display), p, info);
+	}
+
+	template <fixed_string NAME, typename PROPTYPE>
+	PropertyStatus tryGetProperty(const PropertyKey<NAME, PROPTYPE> key, Property<PROPTYPE> &p, const PropertyInfo *info = nullptr) const {
+		return tryGetProperty(key.atomFor(*m_display), p, info);
+	}
+
 	/// Store a property in this window object by name.
 	/**
 	 * Sets the property `name` for the current window to the value
 	 * stored in `p`.
 	 *
+	 * With PropertyMode::APPEND or PropertyMode::PREPEND the data in `p`
+	 * is added to the existing property data. In this case the type and
+	 * format of `p` need to match the existing property, otherwise the X
+	 * server reports a BadMatch error. If the property doesn't exist yet
+	 * then it is created like with PropertyMode::REPLACE.
+	 *
 	 * On error an exception is thrown.
 	 **/
 	template <typename PROPTYPE>
-	void setProperty(const cosmos::SysString name, const Property<PROPTYPE> &p) {
-		setProperty(display.mapAtom(name), p);
+	RequestToken setProperty(const cosmos::SysString name, const Property<PROPTYPE> &p,
+			const PropertyMode mode = PropertyMode::REPLACE) {
+		return setProperty(m_display->atomMapper().mapAtom(name.view()), p, mode);
+	}
+
+	/// Store a property in this window object by PropertyKey.
+	template <fixed_string NAME, typename PROPTYPE>
+	RequestToken setProperty(const PropertyKey<NAME, PROPTYPE> key, const Property<PROPTYPE> &p,
+			const PropertyMode mode = PropertyMode::REPLACE) {
+		return setProperty(key.atomFor(*m_display), p, mode);
+	}
+
+	/// Store a property in this window object by CachedAtom.
+	/**
+	 * The atom is resolved for the display of this window.
+	 **/
+	template <typename PROPTYPE>
+	RequestToken setProperty(const CachedAtom &atom, const Property<PROPTYPE> &p,
+			const PropertyMode mode = PropertyMode::REPLACE) {
+		return setProperty(atom.atom(*m_display), p, mode);
 	}
 
 	/// Store a property in this window object by AtomID.
@@ -333,19 +478,50 @@ public: // functions
 	 * \see setProperty(const std::string&, const Property<PROPTYPE>&)
 	 **/
 	template <typename PROPTYPE>
-	void setProperty(const AtomID name_atom, const Property<PROPTYPE> &p);
+	RequestToken setProperty(const AtomID name_atom, const Property<PROPTYPE> &p,
+			const PropertyMode mode = PropertyMode::REPLACE);
+
+	/// Adds the data in `p` to the end of an existing property.
+	/**
+	 * This allows to grow list properties incrementally instead of
+	 * rewriting them completely. `key` can be anything accepted by
+	 * setProperty().
+	 **/
+	template <typename KEY, typename PROPTYPE>
+	RequestToken appendProperty(const KEY &key, const Property<PROPTYPE> &p) {
+		return setProperty(key, p, PropertyMode::APPEND);
+	}
+
+	/// Adds the data in `p` to the beginning of an existing property.
+	/**
+	 * \see appendProperty()
+	 **/
+	template <typename KEY, typename PROPTYPE>
+	RequestToken prependProperty(const KEY &key, const Property<PROPTYPE> &p) {
+		return setProperty(key, p, PropertyMode::PREPEND);
+	}
 
 
 	/// Removes the property of the given name identifier from the window.
-	void delProperty(const std::string &name) {
-		delProperty(display.mapAtom(name));
+	RequestToken delProperty(const std::string &name) {
+		return delProperty(m_display->atomMapper().mapAtom(name));
+	}
+
+	template <fixed_string NAME, typename PROPTYPE>
+	RequestToken delProperty(const PropertyKey<NAME, PROPTYPE> key) {
+		return delProperty(key.atomFor(*m_display));
+	}
+
+	/// Removes the property of the given CachedAtom from the window.
+	RequestToken delProperty(const CachedAtom &atom) {
+		return delProperty(atom.atom(*m_display));
 	}
 
 	/// Removes the property of the given atom identifier from the window.
-	void delProperty(const AtomID name_atom);
+	RequestToken delProperty(const AtomID name_atom);
 
 	/// compares the WinIDs of the given window objects for equality.
-	bool operator==(const XWindow &o) const { return m_win == o.m_win; }
+	bool operator==(const XWindow &o) const { return m_win == o.m_win && m_display == o.m_display; }
 	bool operator!=(const XWindow &o) const { return !operator==(o); }
 
 	/// Returns the next queued window event that matches the given event mask.
@@ -391,6 +567,27 @@ public: // functions
 		selectEvent(EventMask::PROPERTY_CHANGE);
 	}
 
+	/// Adds `events` to our event selection, keeping events selected elsewhere.
+	/**
+	 * The select*Event() functions only know about the events selected
+	 * via this object. Selecting events on a freshly constructed XWindow
+	 * thus replaces whatever the client selected for the window via other
+	 * objects. This function obtains the current selection from the X
+	 * server first and merges `events` into it, which costs a round trip.
+	 *
+	 * \return The event selection that was active before, which can be
+	 * passed to restoreEventSelection() once the events are no longer
+	 * needed.
+	 **/
+	EventSelectionMask mergeEventSelection(const EventSelectionMask events) const;
+
+	/// Reverts a previous mergeEventSelection() to the given selection.
+	/**
+	 * The window might already be gone at this point, which is why any
+	 * error resulting from the request is silently discarded.
+	 **/
+	void restoreEventSelection(const EventSelectionMask previous) const;
+
 	/// transparently cast the object into the raw WinID identifier.
 	operator WinID() const { return m_win; }
 
@@ -401,14 +598,14 @@ public: // functions
 	void getAttrs(XWindowAttrs &attrs);
 
 	/// Sets new window attributes according to the given mask.
-	void setWindowAttrs(const XSetWindowAttributes &attrs, const WindowAttrMask &mask);
+	RequestToken setWindowAttrs(const XSetWindowAttributes &attrs, const WindowAttrMask &mask);
 
 	/// Move and or resize the window
 	/**
 	 * The x, y, width and height parameters from `attrs` will be used to
 	 * perform the operation.
 	 **/
-	void moveResize(const XWindowAttrs &attrs);
+	RequestToken moveResize(const XWindowAttrs &attrs);
 
 	void setParent(const WinID id) { m_parent = id; }
 
@@ -430,10 +627,10 @@ public: // functions
 	void updateFamily();
 
 	/// Sends the given XEvent structure to the represented X11 window.
-	void sendEvent(const XEvent &event);
+	RequestToken sendEvent(const XEvent &event);
 
 	/// Sends the given xpp::Event wrapper object to the represented X11 window.
-	void sendEvent(const Event &event);
+	RequestToken sendEvent(const Event &event);
 
 	/// Copies image data from the given Pixmap into the window.
 	/**
@@ -441,11 +638,11 @@ public: // functions
 	 * \param[in] src_pos The upper-left coordinate of the copy area in the source pixmap
 	 * \param[in] dst_pos The upper-left coordinate of the copy area in the dest window
 	 **/
-	void copyArea(const GraphicsContext &gc, const PixmapID px,
+	RequestToken copyArea(const GraphicsContext &gc, const PixmapID px,
 			const Extent &ext, const Coord &src_pos = Coord{0,0}, const Coord &dst_pos = Coord{0,0});
 
 	/// Use the given XCursor type as cursor in the associated window.
-	void defineCursor(const XCursor &cursor);
+	RequestToken defineCursor(const XCursor &cursor);
 
 protected: // functions
 
@@ -485,12 +682,37 @@ protected: // functions
 		const XWindow *window = nullptr
 	);
 
+protected: // types
+
+	/// Details about a property query needed for error reporting.
+	struct QueryDetails {
+		AtomID expected_type = AtomID::INVALID;
+		AtomID actual_type = AtomID::INVALID;
+		int x_error = Success;
+	};
+
 protected: // functions
 
 	Window rawID() const;
 
+	/// Common implementation of getProperty() and tryGetProperty().
+	template <typename PROPTYPE>
+	PropertyStatus queryProperty(const AtomID name_atom, Property<PROPTYPE> &p,
+			const PropertyInfo *info, QueryDetails &details) const;
+
+	/// Performs XGetWindowProperty() for getRawProperty() and returns its result.
+	int queryRawProperty(const AtomID property, PropertyInfo &info, RawProperty &out) const;
+
+	/// Common implementation of getClass() and tryGetClass().
+	PropertyStatus queryClass(ClassStringPair &out, QueryDetails &details) const;
+
+	/// Throws the exception matching a failed property query.
+	[[noreturn]] void throwQueryError(const PropertyStatus status, const QueryDetails &details) const;
+
 protected: // data
 
+	/// The display the window belongs to
+	XDisplay *m_display = &xpp::display;
 	/// The X11 window ID this object represents
 	WinID m_win = WinID::INVALID;
 	/// The X11 window ID of the parent of this window
@@ -512,10 +734,34 @@ extern template XPP_API void XWindow::getProperty(const AtomID, Property<std::ve
 extern template XPP_API void XWindow::getProperty(const AtomID, Property<std::vector<WinID> >&, const PropertyInfo*) const;
 extern template XPP_API void XWindow::getProperty(const AtomID, Property<std::vector<int> >&, const PropertyInfo*) const;
 extern template XPP_API void XWindow::getProperty(const AtomID, Property<std::vector<utf8_string> >&, const PropertyInfo*) const;
+extern template XPP_API void XWindow::getProperty(const AtomID, Property<PropertyView<int> >&, const PropertyInfo*) const;
+extern template XPP_API void XWindow::getProperty(const AtomID, Property<PropertyView<AtomID> >&, const PropertyInfo*) const;
+extern template XPP_API void XWindow::getProperty(const AtomID, Property<PropertyView<WinID> >&, const PropertyInfo*) const;
+extern template XPP_API void XWindow::getProperty(const AtomID, Property<PropertyView<utf8_string> >&, const PropertyInfo*) const;
 extern template XPP_API void XWindow::getProperty(const AtomID, Property<utf8_string>&, const PropertyInfo*) const;
-extern template XPP_API void XWindow::setProperty(const AtomID, const Property<const char*>&);
-extern template XPP_API void XWindow::setProperty(const AtomID, const Property<int>&);
-extern template XPP_API void XWindow::setProperty(const AtomID, const Property<utf8_string>&);
-extern template XPP_API void XWindow::setProperty(const AtomID, const Property<AtomID>&);
+extern template XPP_API void XWindow::getProperty(const AtomID, Property<WindowIcons>&, const PropertyInfo*) const;
+extern template XPP_API PropertyStatus XWindow::tryGetProperty(const AtomID, Property<int>&, const PropertyInfo*) const;
+extern template XPP_API PropertyStatus XWindow::tryGetProperty(const AtomID, Property<const char*>&, const PropertyInfo*) const;
+extern template XPP_API PropertyStatus XWindow::tryGetProperty(const AtomID, Property<AtomID>&, const PropertyInfo*) const;
+extern template XPP_API PropertyStatus XWindow::tryGetProperty(const AtomID, Property<WinID>&, const PropertyInfo*) const;
+extern template XPP_API PropertyStatus XWindow::tryGetProperty(const AtomID, Property<std::vector<AtomID> >&, const PropertyInfo*) const;
+extern template XPP_API PropertyStatus XWindow::tryGetProperty(const AtomID, Property<std::vector<WinID> >&, const PropertyInfo*) const;
+extern template XPP_API PropertyStatus XWindow::tryGetProperty(const AtomID, Property<std::vector<int> >&, const PropertyInfo*) const;
+extern template XPP_API PropertyStatus XWindow::tryGetProperty(const AtomID, Property<std::vector<utf8_string> >&, const PropertyInfo*) const;
+extern template XPP_API PropertyStatus XWindow::tryGetProperty(const AtomID, Property<PropertyView<int> >&, const PropertyInfo*) const;
+extern template XPP_API PropertyStatus XWindow::tryGetProperty(const AtomID, Property<PropertyView<AtomID> >&, const PropertyInfo*) const;
+extern template XPP_API PropertyStatus XWindow::tryGetProperty(const AtomID, Property<PropertyView<WinID> >&, const PropertyInfo*) const;
+extern template XPP_API PropertyStatus XWindow::tryGetProperty(const AtomID, Property<PropertyView<utf8_string> >&, const PropertyInfo*) const;
+extern template XPP_API PropertyStatus XWindow::tryGetProperty(const AtomID, Property<utf8_string>&, const PropertyInfo*) const;
+extern template XPP_API PropertyStatus XWindow::tryGetProperty(const AtomID, Property<WindowIcons>&, const PropertyInfo*) const;
+extern template XPP_API RequestToken XWindow::setProperty(const AtomID, const Property<const char*>&, const PropertyMode);
+extern template XPP_API RequestToken XWindow::setProperty(const AtomID, const Property<int>&, const PropertyMode);
+extern template XPP_API RequestToken XWindow::setProperty(const AtomID, const Property<utf8_string>&, const PropertyMode);
+extern template XPP_API RequestToken XWindow::setProperty(const AtomID, const Property<AtomID>&, const PropertyMode);
+extern template XPP_API RequestToken XWindow::setProperty(const AtomID, const Property<WinID>&, const PropertyMode);
+extern template XPP_API RequestToken XWindow::setProperty(const AtomID, const Property<std::vector<int> >&, const PropertyMode);
+extern template XPP_API RequestToken XWindow::setProperty(const AtomID, const Property<std::vector<AtomID> >&, const PropertyMode);
+extern template XPP_API RequestToken XWindow::setProperty(const AtomID, const Property<std::vector<WinID> >&, const PropertyMode);
+extern template XPP_API RequestToken XWindow::setProperty(const AtomID, const Property<std::vector<utf8_string> >&, const PropertyMode);
 
 } // end ns
@@ -3,6 +3,9 @@
 // C++
 #include <optional>
 
+// cosmos
+#include <cosmos/utils.hxx>
+
 // xpp
 #include <xpp/dso_export.h>
 
@@ -18,6 +21,9 @@ namespace cosmos {
 
 namespace xpp {
 
+/// Strong boolean type to select thread-safe Xlib operation in init().
+using ThreadSafe = cosmos::NamedBool<struct thread_safe_t, true>;
+
 /// Initializes the xpp library before first use.
 /**
  * The initialization of the library is required before any other
@@ -31,8 +37,12 @@ namespace xpp {
  *
  * \param[in,out] logger If set then this Cosmos logger instance will be used
  * for runtime error or debugging messages presenting internal library state.
+ * \param[in] thread_safe If set then XInitThreads() is called to make Xlib
+ * usable from multiple threads. Applications that access the display only
+ * from a single thread, e.g. via a ConnectionThread, can disable this to
+ * avoid the Xlib locking overhead.
  **/
-void XPP_API init(std::optional<cosmos::ILogger*> logger);
+void XPP_API init(std::optional<cosmos::ILogger*> logger, const ThreadSafe thread_safe = ThreadSafe{true});
 
 void XPP_API finish();
 
@@ -41,7 +51,10 @@ void XPP_API finish();
  * During the lifetime of this object the cosmos library remains initialized.
  **/
 struct XPP_API Init {
-	explicit Init(std::optional<cosmos::ILogger*> logger = std::nullopt) { init(logger); }
+	explicit Init(std::optional<cosmos::ILogger*> logger = std::nullopt,
+			const ThreadSafe thread_safe = ThreadSafe{true}) {
+		init(logger, thread_safe);
+	}
 
 	~Init() { finish(); }
 };
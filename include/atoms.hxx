@@ -32,6 +32,8 @@ namespace xpp::atoms {
 inline constexpr CachedAtom ewmh_window_name{"_NET_WM_NAME"};
 /// Window icon name property (EWMH).
 inline constexpr CachedAtom ewmh_icon_name{"_NET_WM_ICON_NAME"};
+/// ARGB icon images of a window (EWMH).
+inline constexpr CachedAtom ewmh_wm_icon{"_NET_WM_ICON"};
 /// Name of UTF8 string type.
 inline constexpr CachedAtom ewmh_utf8_string{"UTF8_STRING"};
 /// Property containing an array of windows managed by EWMH comp. WM.
@@ -84,10 +86,50 @@ inline constexpr CachedAtom icccm_wm_locale{"WM_LOCALE_NAME"};
 inline constexpr CachedAtom icccm_wm_client_leader{"WM_CLIENT_LEADER"};
 /// clipboard selection identifier
 inline constexpr CachedAtom clipboard{"CLIPBOARD"};
+/// property type announcing an incremental selection transfer.
+inline constexpr CachedAtom icccm_incr{"INCR"};
 /// primary selection identifier
 inline constexpr CachedAtom primary_selection{AtomID{XA_PRIMARY}};
 /// non-UTF8 ASCII string type
 inline constexpr CachedAtom string_type{AtomID{XA_STRING}};
 inline constexpr CachedAtom wm_icon_name{AtomID{XA_WM_ICON_NAME}};
 
+/// All of the above atoms that need to be resolved at runtime.
+/**
+ * These are resolved in bulk during xpp::init(), see resolve_cached_atoms().
+ * When adding new atoms above then also add them here.
+ **/
+inline constexpr const CachedAtom* all[] = {
+	&ewmh_window_name,
+	&ewmh_icon_name,
+	&ewmh_wm_icon,
+	&ewmh_utf8_string,
+	&ewmh_wm_window_list,
+	&ewmh_window_desktop,
+	&ewmh_window_pid,
+	&ewmh_support_check,
+	&ewmh_wm_pid,
+	&ewmh_wm_state,
+	&ewmh_wm_state_toggle,
+	&ewmh_wm_state_fullscreen,
+	&ewmh_wm_desktop_shown,
+	&ewmh_wm_nr_desktops,
+	&ewmh_wm_desktop_names,
+	&ewmh_wm_cur_desktop,
+	&ewmh_desktop_nr,
+	&ewmh_wm_active_window,
+	&ewmh_wm_window_type,
+	&icccm_client_machine,
+	&icccm_window_name,
+	&icccm_wm_protocols,
+	&icccm_wm_delete_window,
+	&icccm_wm_client_machine,
+	&icccm_wm_class,
+	&icccm_wm_command,
+	&icccm_wm_locale,
+	&icccm_wm_client_leader,
+	&clipboard,
+	&icccm_incr
+};
+
 } // end ns
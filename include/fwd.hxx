@@ -6,12 +6,22 @@
  **/
 
 namespace xpp {
+	class CaptureRing;
+	class ConnectionThread;
+	class ErrorChannel;
 	class Event;
+	class EventCoalescer;
+	class EventRecorder;
 	class GraphicsContext;
+	class Image;
 	class Pixmap;
+	class PropertyBatch;
+	class RequestBatch;
+	struct RequestToken;
 	class RootWin;
 	class SetWindowAttributes;
 	class SizeHints;
+	class WindowIcons;
 	class WindowManagerHints;
 	class XColor;
 	class XCursor;
@@ -20,6 +30,7 @@ namespace xpp {
 	class XWindowAttrs;
 	struct utf8_string;
 	template <typename PROPTYPE> class Property;
+	template <typename ELEM> class PropertyView;
 
 	class AnyEvent;
 	class ButtonEvent;
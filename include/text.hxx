@@ -0,0 +1,69 @@
+#pragma once
+
+// C++
+#include <string_view>
+#include <vector>
+
+// xpp
+#include <xpp/dso_export.h>
+
+/**
+ * @file
+ *
+ * Decoding helpers for text properties.
+ *
+ * Text list properties like _NET_DESKTOP_NAMES or WM_CLASS consist of
+ * strings separated by NUL bytes. The functions in here split such data and
+ * validate UTF-8 encoding in a single pass. The scan is bounded by the
+ * number of bytes actually received, no terminator is required.
+ *
+ * On x86 the scan processes 16 (SSE2) or 32 (AVX2) bytes at once. Blocks
+ * consisting of ASCII characters only, the common case for these
+ * properties, are handled completely in vector registers. Blocks
+ * containing multi-byte sequences are validated by a scalar state machine.
+ * The implementation is selected at runtime according to the CPU's
+ * capabilities.
+ **/
+
+namespace xpp::text {
+
+/// Available implementations of the text scanning functions.
+enum class SimdLevel {
+	SCALAR,
+	SSE2,
+	AVX2
+};
+
+/// Returns the best implementation supported by the current CPU.
+XPP_API SimdLevel detected_simd_level();
+
+/// Returns the implementation currently in use.
+XPP_API SimdLevel simd_level();
+
+/// Selects the implementation to use, e.g. for testing or benchmarking.
+/**
+ * Levels not supported by the CPU are reduced to detected_simd_level().
+ *
+ * \return The level actually selected.
+ **/
+XPP_API SimdLevel set_simd_level(const SimdLevel level);
+
+/// Splits NUL separated strings in `data` and validates their UTF-8 encoding.
+/**
+ * `out` is cleared and receives a view into `data` for each string. A
+ * terminating NUL after the last string is optional. Consecutive NULs
+ * result in empty strings.
+ *
+ * \return Whether `data` is valid UTF-8. The strings are returned in any
+ * case, callers can decide how to deal with broken encodings.
+ **/
+XPP_API bool split_list(const std::string_view data, std::vector<std::string_view> &out);
+
+/// Returns whether `data` is valid UTF-8.
+/**
+ * NUL bytes are valid UTF-8 on their own, this can thus also be used for
+ * complete list properties.
+ **/
+XPP_API bool is_valid_utf8(const std::string_view data);
+
+} // end ns
@@ -130,6 +130,23 @@ struct RawProperty {
 	auto view() const { return std::string_view{reinterpret_cast<const char*>(data.get()), length}; }
 };
 
+/// How XWindow::setProperty() combines new data with an existing property.
+enum class PropertyMode : int {
+	REPLACE = PropModeReplace, ///< the existing data is discarded
+	PREPEND = PropModePrepend, ///< the new data is inserted before the existing data
+	APPEND  = PropModeAppend   ///< the new data is added after the existing data
+};
+
+/// Outcome of a property query for APIs that don't report errors via exceptions.
+enum class PropertyStatus {
+	OK,            ///< the property was successfully retrieved
+	PENDING,       ///< the query has not been carried out yet
+	NOT_EXISTING,  ///< the property is not present on the window
+	TYPE_MISMATCH, ///< the property has a different type or format than requested
+	TRUNCATED,     ///< the property is larger than the maximum length requested
+	QUERY_ERROR    ///< the X server reported an error, e.g. for a bad window
+};
+
 enum class WindowAttr : unsigned long {
 	BACK_PIXMAP       = CWBackPixmap,
 	BACK_PIXEL        = CWBackPixel,
@@ -196,6 +213,13 @@ enum class EventType : int {
 	MAPPING_NOTIFY    = MappingNotify
 };
 
+/// Modes for checking the event queue via XDisplay::eventsQueued().
+enum class QueueMode : int {
+	ALREADY       = QueuedAlready,      ///< only check events already read into the local queue
+	AFTER_READING = QueuedAfterReading, ///< additionally read any data available on the connection
+	AFTER_FLUSH   = QueuedAfterFlush    ///< additionally flush the output buffer first, like XPending()
+};
+
 enum class EventMask : long {
 	NO_EVENT              = NoEventMask,
 	KEY_PRESSES           = KeyPressMask,
@@ -4,6 +4,9 @@
 #include <string>
 #include <string_view>
 
+// xpp
+#include <xpp/text.hxx>
+
 namespace xpp {
 
 /// A type used for differentiation between a plain ASCII string and an Xlib utf8 string.
@@ -31,6 +34,13 @@ struct utf8_string {
 
 	size_t length() { return str.length(); }
 
+	/// Returns whether the string is actually UTF-8 encoded.
+	/**
+	 * Clients may store arbitrary data in UTF8_STRING properties, libxpp
+	 * doesn't reject such data when retrieving properties.
+	 **/
+	bool valid() const { return text::is_valid_utf8(str); }
+
 	std::string_view str;
 };
 
@@ -1,5 +1,9 @@
+// C++
+#include <functional>
+#include <string_view>
+
 // cosmos
-#include <cosmos/thread/RWLock.hxx>
+#include <cosmos/thread/Mutex.hxx>
 
 // xpp
 #include <xpp/AtomMapper.hxx>
@@ -11,55 +15,208 @@ namespace xpp {
 
 AtomMapper atom_mapper;
 
-AtomID AtomMapper::mapAtom(const std::string_view s) const {
-	{
-		cosmos::ReadLockGuard g{m_mappings_lock};
+namespace {
 
-		if (auto it = m_mappings.find(std::string{s}); it != m_mappings.end()) {
-			return AtomID{it->second};
-		}
+	size_t hash_name(const std::string_view s) {
+		return std::hash<std::string_view>{}(s);
+	}
+
+	constexpr size_t INITIAL_NAME_CAPACITY = 256;
+
+} // end anon ns
+
+AtomMapper::NameTable::NameTable(const size_t capacity) :
+		mask{capacity - 1},
+		slots{new std::atomic<const Entry*>[capacity]} {
+	for (size_t slot = 0; slot < capacity; slot++) {
+		slots[slot].store(nullptr, std::memory_order_relaxed);
+	}
+}
+
+AtomMapper::~AtomMapper() {
+	delete m_names.load();
+
+	for (auto &chunk: m_ids) {
+		delete chunk.load();
+	}
+}
+
+void AtomMapper::clear() {
+	cosmos::MutexGuard g{m_update_lock};
+
+	delete m_names.exchange(nullptr);
+
+	for (auto &chunk: m_ids) {
+		delete chunk.exchange(nullptr);
+	}
+
+	m_sparse_ids.clear();
+	m_retired_names.clear();
+	m_entries.clear();
+}
+
+AtomID AtomMapper::mapAtom(const std::string_view s) const {
+	if (auto entry = findName(s, hash_name(s)); entry) {
+		return entry->id;
 	}
 
 	return cacheMiss(s);
 }
 
+size_t AtomMapper::cacheAtoms(const std::vector<std::string_view> &names) const {
+	// null terminated copies of the missing names
+	std::vector<std::string> missing;
+
+	for (const auto name: names) {
+		if (findName(name, hash_name(name)))
+			continue;
+
+		missing.emplace_back(name);
+	}
+
+	if (missing.empty())
+		return 0;
+
+	std::vector<cosmos::SysString> sys_names{missing.begin(), missing.end()};
+	AtomIDVector atoms;
+
+	m_display->mapAtoms(sys_names, atoms);
+
+	Xpp::getLogger().debug() << "Resolved " << atoms.size() << " atom ids in a single request" << std::endl;
+
+	cosmos::MutexGuard g{m_update_lock};
+
+	for (size_t num = 0; num < missing.size(); num++) {
+		insert(missing[num], atoms[num]);
+	}
+
+	return missing.size();
+}
+
 const std::string& AtomMapper::mapName(const AtomID atom) const {
-	{
-		cosmos::ReadLockGuard g{m_mappings_lock};
+	if (auto entry = findID(atom); entry) {
+		return entry->name;
+	}
 
-		for (const auto &pair: m_mappings) {
-			if (pair.second == atom) {
-				return pair.first;
-			}
+	return cacheMiss(atom);
+}
+
+const AtomMapper::Entry* AtomMapper::findName(const std::string_view s, const size_t hash) const {
+	const auto table = m_names.load(std::memory_order_acquire);
+
+	if (!table)
+		return nullptr;
+
+	for (size_t slot = hash & table->mask; true; slot = (slot + 1) & table->mask) {
+		const auto entry = table->slots[slot].load(std::memory_order_acquire);
+
+		if (!entry) {
+			return nullptr;
+		} else if (entry->hash == hash && entry->name == s) {
+			return entry;
 		}
 	}
+}
 
-	return cacheMiss(atom);
+const AtomMapper::Entry* AtomMapper::findID(const AtomID atom) const {
+	const auto raw = raw_atom(atom);
+
+	if (raw < DENSE_IDS) {
+		const auto chunk = m_ids[raw >> ID_CHUNK_BITS].load(std::memory_order_acquire);
+
+		if (!chunk)
+			return nullptr;
+
+		return (*chunk)[raw & ((1 << ID_CHUNK_BITS) - 1)].load(std::memory_order_acquire);
+	}
+
+	cosmos::MutexGuard g{m_update_lock};
+
+	if (auto it = m_sparse_ids.find(atom); it != m_sparse_ids.end()) {
+		return it->second;
+	}
+
+	return nullptr;
 }
 
-const std::string& AtomMapper::cacheMiss(const AtomID atom) const {
-	const auto name = display.mapName(atom);
+void AtomMapper::insertName(NameTable &table, const Entry &entry) {
+	auto slot = entry.hash & table.mask;
+
+	while (table.slots[slot].load(std::memory_order_relaxed)) {
+		slot = (slot + 1) & table.mask;
+	}
+
+	table.slots[slot].store(&entry, std::memory_order_release);
+	table.used++;
+}
+
+const AtomMapper::Entry& AtomMapper::insert(const std::string_view s, const AtomID atom) const {
+	const auto hash = hash_name(s);
+
+	// somebody else might have resolved the same mapping in the meantime
+	if (auto entry = findName(s, hash); entry) {
+		return *entry;
+	}
 
-	{
-		cosmos::WriteLockGuard g(m_mappings_lock);
-		auto ret = m_mappings.insert(std::make_pair(name, atom));
+	const auto &entry = m_entries.emplace_back(Entry{std::string{s}, atom, hash});
 
-		return (ret.first)->first;
+	auto table = m_names.load(std::memory_order_relaxed);
+
+	if (!table || (table->used + 1) * 2 > table->mask + 1) {
+		// grow the table and publish the new one once it is complete
+		const auto capacity = table ? (table->mask + 1) * 2 : INITIAL_NAME_CAPACITY;
+		auto grown = new NameTable{capacity};
+
+		for (const auto &existing: m_entries) {
+			insertName(*grown, existing);
+		}
+
+		m_names.store(grown, std::memory_order_release);
+
+		if (table) {
+			m_retired_names.emplace_back(table);
+		}
+	} else {
+		insertName(*table, entry);
+	}
+
+	const auto raw = raw_atom(atom);
+
+	if (raw < DENSE_IDS) {
+		auto &chunk_ptr = m_ids[raw >> ID_CHUNK_BITS];
+		auto chunk = chunk_ptr.load(std::memory_order_relaxed);
+
+		if (!chunk) {
+			chunk = new IDChunk{};
+			for (auto &slot: *chunk) {
+				slot.store(nullptr, std::memory_order_relaxed);
+			}
+			chunk_ptr.store(chunk, std::memory_order_release);
+		}
+
+		(*chunk)[raw & ((1 << ID_CHUNK_BITS) - 1)].store(&entry, std::memory_order_release);
+	} else {
+		m_sparse_ids[atom] = &entry;
 	}
+
+	return entry;
+}
+
+const std::string& AtomMapper::cacheMiss(const AtomID atom) const {
+	const auto name = m_display->mapName(atom);
+
+	cosmos::MutexGuard g{m_update_lock};
+	return insert(name, atom).name;
 }
 
 AtomID AtomMapper::cacheMiss(const std::string_view s) const {
 	auto &logger = Xpp::getLogger();
-	AtomID ret{display.mapAtom(std::string{s})};
+	AtomID ret{m_display->mapAtom(std::string{s})};
 
 	logger.debug() << "Resolved atom id for '" << s << "' is " << raw_atom(ret) << std::endl;
 
-	{
-		cosmos::WriteLockGuard g{m_mappings_lock};
-		m_mappings.insert(std::make_pair(s, ret));
-	}
-
-	return ret;
+	cosmos::MutexGuard g{m_update_lock};
+	return insert(s, ret).id;
 }
 
 } // end ns
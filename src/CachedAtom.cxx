@@ -1,11 +1,100 @@
+// C++
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+// cosmos
+#include <cosmos/thread/Mutex.hxx>
+
 // xpp
 #include <xpp/AtomMapper.hxx>
+#include <xpp/atoms.hxx>
 #include <xpp/CachedAtom.hxx>
+#include <xpp/private/Xpp.hxx>
+#include <xpp/XDisplay.hxx>
 
 namespace xpp {
 
+namespace {
+
+	/// CachedAtom instances registered by the application.
+	std::vector<const CachedAtom*> g_registered_atoms;
+	cosmos::Mutex g_registered_atoms_lock;
+
+} // end anon ns
+
 void CachedAtom::resolve() const {
 	m_id = atom_mapper.mapAtom(m_name);
 }
 
+AtomID CachedAtom::atom(XDisplay &disp) const {
+	// literal AtomIDs are predefined atoms, valid on any display
+	if (&disp == &display || m_name.empty()) {
+		return atom();
+	}
+
+	return disp.atomMapper().mapAtom(m_name);
+}
+
+void register_cached_atoms(const std::initializer_list<const CachedAtom*> atoms) {
+	cosmos::MutexGuard g{g_registered_atoms_lock};
+	g_registered_atoms.insert(g_registered_atoms.end(), atoms.begin(), atoms.end());
+}
+
+void forget_cached_atoms() {
+	cosmos::MutexGuard g{g_registered_atoms_lock};
+
+	auto forget = [](const CachedAtom *atom) {
+		// literal AtomIDs are valid on any display
+		if (!atom->m_name.empty()) {
+			atom->m_id.reset();
+		}
+	};
+
+	std::for_each(std::begin(atoms::all), std::end(atoms::all), forget);
+	std::for_each(g_registered_atoms.begin(), g_registered_atoms.end(), forget);
+}
+
+size_t resolve_cached_atoms() {
+	return resolve_cached_atoms(display);
+}
+
+size_t resolve_cached_atoms(XDisplay &disp) {
+	std::vector<const CachedAtom*> pending;
+
+	{
+		cosmos::MutexGuard g{g_registered_atoms_lock};
+		pending.insert(pending.end(), std::begin(atoms::all), std::end(atoms::all));
+		pending.insert(pending.end(), g_registered_atoms.begin(), g_registered_atoms.end());
+	}
+
+	std::vector<std::string_view> names;
+
+	for (const auto atom: pending) {
+		// instances for literal AtomIDs have no name
+		if (!atom->name().empty()) {
+			names.push_back(atom->name());
+		}
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	const auto resolved = disp.atomMapper().cacheAtoms(names);
+
+	if (&disp == &display) {
+		// these are all cache hits now
+		for (const auto atom: pending) {
+			(void)atom->atom();
+		}
+	}
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - start);
+
+	Xpp::getLogger().debug() << "Bulk resolved " << resolved << " cached atoms in "
+		<< elapsed.count() << " µs" << std::endl;
+
+	return resolved;
+}
+
 } // end ns
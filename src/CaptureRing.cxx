@@ -0,0 +1,117 @@
+// cosmos
+#include <cosmos/error/UsageError.hxx>
+#include <cosmos/thread/Mutex.hxx>
+
+// xpp
+#include <xpp/CaptureRing.hxx>
+#include <xpp/helpers.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/XWindowAttrs.hxx>
+
+namespace xpp {
+
+namespace {
+
+	WindowSpec window_area(const XWindow &source) {
+		// getAttrs() is not const
+		XWindow win{source};
+		XWindowAttrs attrs;
+		win.getAttrs(attrs);
+		return WindowSpec{0, 0,
+			static_cast<unsigned>(attrs.width),
+			static_cast<unsigned>(attrs.height)};
+	}
+
+} // end anon ns
+
+CaptureRing::CaptureRing(const DrawableID source, const WindowSpec area, const size_t slots,
+			const UseShm use_shm, XDisplay &disp) :
+		m_display{disp},
+		m_source{source},
+		m_area{area} {
+	setup(slots, use_shm);
+}
+
+CaptureRing::CaptureRing(const XWindow &source, const std::optional<WindowSpec> area,
+			const size_t slots, const UseShm use_shm) :
+		m_display{source.getDisplay()},
+		m_source{to_drawable(source.id())},
+		m_area{area ? *area : window_area(source)} {
+	setup(slots, use_shm);
+}
+
+void CaptureRing::setup(const size_t slots, const UseShm use_shm) {
+	if (slots == 0 || m_area.width == 0 || m_area.height == 0) {
+		cosmos_throw (cosmos::UsageError("CaptureRing needs at least one slot and a non-empty area"));
+	}
+
+	m_images.reserve(slots);
+
+	for (size_t slot = 0; slot < slots; slot++) {
+		m_images.emplace_back(Extent{m_area.width, m_area.height}, use_shm, m_display);
+	}
+
+	m_busy.assign(slots, false);
+}
+
+size_t CaptureRing::acquireSlot() {
+	cosmos::MutexGuard g{m_lock};
+
+	while (true) {
+		for (size_t i = 0; i < m_busy.size(); i++) {
+			const auto slot = (m_next + i) % m_busy.size();
+
+			if (!m_busy[slot]) {
+				m_busy[slot] = true;
+				m_next = (slot + 1) % m_busy.size();
+				return slot;
+			}
+		}
+
+		m_lock.wait();
+	}
+}
+
+CaptureRing::Frame CaptureRing::capture() {
+	const auto slot = acquireSlot();
+	auto &image = m_images[slot];
+
+	try {
+		image.getImage(m_source, Coord{m_area.x, m_area.y});
+	} catch (...) {
+		releaseSlot(slot);
+		throw;
+	}
+
+	return Frame{&image, slot, m_sequence++, std::chrono::steady_clock::now()};
+}
+
+void CaptureRing::release(const Frame &frame) {
+	if (frame.slot >= m_images.size() || frame.image != &m_images[frame.slot]) {
+		cosmos_throw (cosmos::UsageError("frame does not belong to this CaptureRing"));
+	}
+
+	releaseSlot(frame.slot);
+}
+
+void CaptureRing::releaseSlot(const size_t slot) {
+	cosmos::MutexGuard g{m_lock};
+	m_busy[slot] = false;
+	m_lock.signal();
+}
+
+uint64_t CaptureRing::stream(const Callback &callback, const std::optional<uint64_t> max_frames) {
+	uint64_t count = 0;
+
+	while (!max_frames || count < *max_frames) {
+		const auto frame = capture();
+		count++;
+
+		if (!callback(frame))
+			break;
+	}
+
+	return count;
+}
+
+} // end ns
@@ -0,0 +1,92 @@
+// C++
+#include <exception>
+
+// xpp
+#include <xpp/ConnectionThread.hxx>
+#include <xpp/private/Xpp.hxx>
+#include <xpp/RequestBatch.hxx>
+
+namespace xpp {
+
+ConnectionThread::ConnectionThread(XDisplay &disp) :
+		m_display{disp},
+		m_loop{disp} {
+	m_loop.addFD(m_wakeup.fd(), [this]() { drain(); });
+}
+
+ConnectionThread::~ConnectionThread() {
+	stop();
+	m_loop.removeFD(m_wakeup.fd());
+}
+
+void ConnectionThread::start() {
+	if (running())
+		return;
+
+	m_stopping = false;
+	m_run++;
+	m_thread = std::thread{&ConnectionThread::threadMain, this};
+}
+
+void ConnectionThread::stop() {
+	if (!running())
+		return;
+
+	// if the loop already terminated due to an exception then this
+	// operation is only carried out after the next start(), where it
+	// must not stop the new run.
+	post([this, run = m_run](XDisplay&) {
+		if (run != m_run)
+			return;
+		m_stopping = true;
+		m_loop.stop();
+	});
+
+	m_thread.join();
+	m_thread = std::thread{};
+}
+
+void ConnectionThread::post(Operation op) {
+	m_queue.push(std::move(op));
+
+	// only signal once until the I/O thread consumed the wakeup
+	if (!m_wakeup_pending.exchange(true)) {
+		m_wakeup.signal();
+	}
+}
+
+void ConnectionThread::threadMain() {
+	try {
+		m_loop.run();
+	} catch (const std::exception &ex) {
+		Xpp::getLogger().error() << "X connection thread terminated: " << ex.what() << std::endl;
+	} catch (...) {
+		// don't let anything escape the thread, this would terminate the process
+		Xpp::getLogger().error() << "X connection thread terminated by unknown exception" << std::endl;
+	}
+}
+
+void ConnectionThread::drain() {
+	// consume the wakeup before looking at the queue, operations pushed
+	// from now on will signal again
+	(void)m_wakeup.wait();
+	m_wakeup_pending = false;
+
+	// merge the implicit flushes of all operations in this batch
+	RequestBatch batch{m_display};
+	Operation op;
+
+	while (!m_stopping && m_queue.pop(op)) {
+		try {
+			op(m_display);
+		} catch (const std::exception &ex) {
+			Xpp::getLogger().warn() << "Posted X operation failed: " << ex.what() << std::endl;
+		} catch (...) {
+			Xpp::getLogger().warn() << "Posted X operation failed with unknown exception" << std::endl;
+		}
+	}
+
+	batch.finish();
+}
+
+} // end ns
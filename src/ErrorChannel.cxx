@@ -0,0 +1,104 @@
+// C++
+#include <algorithm>
+#include <iterator>
+#include <memory>
+
+// cosmos
+#include <cosmos/error/UsageError.hxx>
+
+// xpp
+#include <xpp/ErrorChannel.hxx>
+#include <xpp/private/errors.hxx>
+#include <xpp/X11Exception.hxx>
+
+namespace xpp {
+
+ErrorChannel::ErrorChannel(XDisplay &disp) :
+		m_display{disp} {
+	m_sink = errors::add_sink([this](Display *dis, const XErrorEvent &ev) {
+		return recordError(dis, ev);
+	});
+}
+
+ErrorChannel::~ErrorChannel() {
+	errors::remove_sink(m_sink);
+}
+
+void ErrorChannel::watch(const RequestToken &token, Callback cb) {
+	if (token.valid() && token.display != &m_display) {
+		throw cosmos::UsageError{"RequestToken belongs to a different display"};
+	}
+
+	cosmos::MutexGuard g{m_lock};
+	m_pending.push_back(Pending{token.first, token.last, std::move(cb), std::nullopt});
+}
+
+std::future<void> ErrorChannel::watch(const RequestToken &token) {
+	auto promise = std::make_shared<std::promise<void>>();
+	auto ret = promise->get_future();
+
+	watch(token, [this, promise](const std::optional<XErrorEvent> &error) {
+		if (error) {
+			promise->set_exception(std::make_exception_ptr(
+					X11Exception{m_display, error->error_code}));
+		} else {
+			promise->set_value();
+		}
+	});
+
+	return ret;
+}
+
+size_t ErrorChannel::process() {
+	const auto processed = m_display.lastProcessedRequest();
+	std::vector<Pending> done;
+
+	{
+		cosmos::MutexGuard g{m_lock};
+
+		auto it = std::stable_partition(m_pending.begin(), m_pending.end(), [processed](const Pending &entry) {
+			return entry.last > processed && entry.last >= entry.first;
+		});
+
+		done.assign(std::make_move_iterator(it), std::make_move_iterator(m_pending.end()));
+		m_pending.erase(it, m_pending.end());
+	}
+
+	// invoke callbacks without holding the lock, they may issue new
+	// requests and watch them
+	for (auto &entry: done) {
+		entry.cb(entry.error);
+	}
+
+	return done.size();
+}
+
+size_t ErrorChannel::settle() {
+	m_display.sync();
+	return process();
+}
+
+size_t ErrorChannel::pending() const {
+	cosmos::MutexGuard g{m_lock};
+	return m_pending.size();
+}
+
+bool ErrorChannel::recordError(Display *dis, const XErrorEvent &ev) {
+	if (dis != m_display)
+		return false;
+
+	cosmos::MutexGuard g{m_lock};
+
+	for (auto &entry: m_pending) {
+		if (ev.serial >= entry.first && ev.serial <= entry.last) {
+			if (!entry.error) {
+				entry.error = ev;
+			}
+			return true;
+		}
+	}
+
+	return false;
+}
+
+} // end ns
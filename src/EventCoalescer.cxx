@@ -0,0 +1,67 @@
+// xpp
+#include <xpp/event/ConfigureEvent.hxx>
+#include <xpp/event/PropertyEvent.hxx>
+#include <xpp/EventCoalescer.hxx>
+
+namespace xpp {
+
+EventCoalescer::Key EventCoalescer::makeKey(const Event &event) {
+	const auto &any = event.toAnyEvent();
+	Key key{WinID{any.window}, WinID::INVALID, AtomID::INVALID, any.type};
+
+	switch (event.type()) {
+		case EventType::PROPERTY_NOTIFY:
+			key.atom = PropertyEvent{event}.property();
+			break;
+		case EventType::CONFIGURE_NOTIFY:
+			key.subject = ConfigureEvent{event}.window();
+			break;
+		default:
+			break;
+	}
+
+	return key;
+}
+
+void EventCoalescer::push(const Event &event) {
+	if (policy(event.type()) == CoalescePolicy::KEEP_ALL) {
+		// only consecutive events are merged
+		flush();
+		if (m_sink)
+			m_sink(event);
+		return;
+	}
+
+	const auto key = makeKey(event);
+
+	if (auto it = m_latest.find(key); it != m_latest.end()) {
+		m_run[it->second].dropped = true;
+		m_run_dropped++;
+		m_dropped++;
+		m_dropped_per_type[key.type]++;
+		it->second = m_run.size();
+	} else {
+		m_latest.emplace(key, m_run.size());
+	}
+
+	m_run.push_back(Slot{event});
+}
+
+void EventCoalescer::flush() {
+	if (m_run.empty())
+		return;
+
+	// the sink might feed new events into us, so start a new run first
+	auto run = std::move(m_run);
+	m_run.clear();
+	m_latest.clear();
+	m_run_dropped = 0;
+
+	for (const auto &slot: run) {
+		if (!slot.dropped && m_sink) {
+			m_sink(slot.event);
+		}
+	}
+}
+
+} // end ns
@@ -0,0 +1,185 @@
+// C++
+#include <algorithm>
+
+// xpp
+#include <xpp/EventLoop.hxx>
+
+namespace xpp {
+
+EventLoop::EventLoop(XDisplay &disp) :
+		m_display{&disp},
+		m_x_fd{disp.connectionNumber()} {
+	m_poller.create();
+	m_poller.addFD(m_x_fd, {cosmos::Poller::MonitorFlag::INPUT});
+}
+
+EventLoop::EventLoop(std::nullptr_t) {
+	m_poller.create();
+}
+
+EventLoop::~EventLoop() {
+	m_poller.close();
+}
+
+void EventLoop::setCoalescer(EventCoalescer *coalescer) {
+	if (m_coalescer) {
+		m_coalescer->flush();
+	}
+
+	m_coalescer = coalescer;
+
+	if (m_coalescer) {
+		m_coalescer->setSink([this](const Event &event) { dispatch(event); });
+	}
+}
+
+void EventLoop::addFD(const cosmos::FileDescriptor fd, Callback cb) {
+	m_poller.addFD(fd, {cosmos::Poller::MonitorFlag::INPUT});
+	m_fd_callbacks[fd.raw()] = std::move(cb);
+}
+
+void EventLoop::removeFD(const cosmos::FileDescriptor fd) {
+	if (m_fd_callbacks.erase(fd.raw()) != 0) {
+		m_poller.delFD(fd);
+	}
+}
+
+EventLoop::TimerID EventLoop::addTimer(const std::chrono::milliseconds delay, Callback cb,
+		const std::optional<std::chrono::milliseconds> interval) {
+	const TimerID id{m_next_timer_id++};
+	// a zero interval would make runTimers() loop forever
+	const auto rearm = interval ?
+		std::optional{std::max(*interval, std::chrono::milliseconds{1})} : std::nullopt;
+	m_timers.emplace(Clock::now() + delay, Timer{id, std::move(cb), rearm});
+	return id;
+}
+
+bool EventLoop::removeTimer(const TimerID id) {
+	auto it = std::find_if(m_timers.begin(), m_timers.end(),
+			[id](const auto &pair) { return pair.second.id == id; });
+
+	if (it == m_timers.end())
+		return false;
+
+	m_timers.erase(it);
+	return true;
+}
+
+void EventLoop::run() {
+	m_running = true;
+
+	while (m_running) {
+		runOnce();
+	}
+}
+
+void EventLoop::runOnce(const std::optional<std::chrono::milliseconds> timeout) {
+	// Xlib may have read events into its queue during other calls, e.g.
+	// while waiting for a reply. These won't cause the connection to
+	// become readable, so process them first.
+	if (m_display) {
+		dispatchQueued();
+		m_display->flush();
+	}
+
+	auto wait_time = nextTimeout();
+	if (timeout && (!wait_time || *timeout < *wait_time)) {
+		wait_time = timeout;
+	}
+
+	for (const auto &event: m_poller.wait(wait_time)) {
+		const auto fd = event.fd();
+
+		if (m_display && fd == m_x_fd.raw()) {
+			// reads all data available on the connection without
+			// blocking, then process the complete batch
+			(void)m_display->eventsQueued(QueueMode::AFTER_READING);
+			dispatchQueued();
+		} else if (auto it = m_fd_callbacks.find(fd); it != m_fd_callbacks.end()) {
+			// copy the callback, it might remove itself
+			auto cb = it->second;
+			cb();
+		}
+	}
+
+	runTimers();
+}
+
+bool EventLoop::dispatch(const Event &event) const {
+	const auto index = static_cast<size_t>(cosmos::to_integral(event.type()));
+
+	if (index < m_handlers.size() && m_handlers[index]) {
+		m_handlers[index](event);
+		return true;
+	} else if (m_default_handler) {
+		m_default_handler(event);
+		return true;
+	}
+
+	return false;
+}
+
+size_t EventLoop::dispatchQueued() {
+	size_t ret = 0;
+	Event event;
+
+	if (!m_display)
+		return ret;
+
+	while (true) {
+		auto queued = m_display->eventsQueued(QueueMode::ALREADY);
+		if (queued == 0)
+			break;
+
+		for (; queued != 0; queued--) {
+			// won't block, the event is already queued
+			m_display->nextEvent(event);
+			if (m_coalescer) {
+				m_coalescer->push(event);
+			} else {
+				dispatch(event);
+			}
+			ret++;
+		}
+	}
+
+	if (m_coalescer) {
+		m_coalescer->flush();
+	}
+
+	return ret;
+}
+
+void EventLoop::runTimers() {
+	const auto now = Clock::now();
+
+	while (!m_timers.empty() && m_timers.begin()->first <= now) {
+		auto node = m_timers.extract(m_timers.begin());
+		auto &timer = node.mapped();
+
+		if (timer.interval) {
+			// rearm before invoking, so that the callback can remove it
+			node.key() = now + *timer.interval;
+			auto it = m_timers.insert(std::move(node));
+			auto cb = it->second.cb;
+			cb();
+		} else {
+			timer.cb();
+		}
+	}
+}
+
+std::optional<std::chrono::milliseconds> EventLoop::nextTimeout() const {
+	if (m_timers.empty())
+		return std::nullopt;
+
+	const auto left = m_timers.begin()->first - Clock::now();
+
+	if (left <= Clock::duration::zero())
+		return std::chrono::milliseconds{0};
+
+	// round up, to avoid waking up shortly before the deadline
+	return std::chrono::ceil<std::chrono::milliseconds>(left);
+}
+
+} // end ns
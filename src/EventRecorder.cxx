@@ -0,0 +1,173 @@
+// C
+#include <stdint.h>
+
+// C++
+#include <cstring>
+#include <thread>
+
+// cosmos
+#include <cosmos/error/RuntimeError.hxx>
+
+// xpp
+#include <xpp/EventRecorder.hxx>
+
+namespace xpp {
+
+namespace {
+
+	constexpr char MAGIC[8] = {'X', 'P', 'P', 'E', 'V', 'R', 'E', 'C'};
+	constexpr uint32_t VERSION = 1;
+
+	struct FileHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t event_size;
+	};
+
+	struct RecordHeader {
+		uint64_t offset_ns;
+		int32_t type;
+		uint16_t size;
+	} __attribute__((packed));
+
+} // end anon ns
+
+size_t event_data_size(const EventType type) {
+	switch (type) {
+		case EventType::KEY_PRESS:
+		case EventType::KEY_RELEASE:       return sizeof(XKeyEvent);
+		case EventType::BUTTON_PRESS:
+		case EventType::BUTTON_RELEASE:    return sizeof(XButtonEvent);
+		case EventType::MOTION_NOTIFY:     return sizeof(XMotionEvent);
+		case EventType::ENTER_NOTIFY:
+		case EventType::LEAVE_NOTIFY:      return sizeof(XCrossingEvent);
+		case EventType::FOCUS_IN:
+		case EventType::FOCUS_OUT:         return sizeof(XFocusChangeEvent);
+		case EventType::KEYMAP_NOTIFY:     return sizeof(XKeymapEvent);
+		case EventType::EXPOSE:            return sizeof(XExposeEvent);
+		case EventType::GRAPHICS_EXPOSE:   return sizeof(XGraphicsExposeEvent);
+		case EventType::NOEXPOSE:          return sizeof(XNoExposeEvent);
+		case EventType::VISIBILITY_NOTIFY: return sizeof(XVisibilityEvent);
+		case EventType::CREATE_NOTIFY:     return sizeof(XCreateWindowEvent);
+		case EventType::DESTROY_NOTIFY:    return sizeof(XDestroyWindowEvent);
+		case EventType::UNMAP_NOTIFY:      return sizeof(XUnmapEvent);
+		case EventType::MAP_NOTIFY:        return sizeof(XMapEvent);
+		case EventType::MAP_REQUEST:       return sizeof(XMapRequestEvent);
+		case EventType::REPARENT_NOTIFY:   return sizeof(XReparentEvent);
+		case EventType::CONFIGURE_NOTIFY:  return sizeof(XConfigureEvent);
+		case EventType::CONFIGURE_REQUEST: return sizeof(XConfigureRequestEvent);
+		case EventType::GRAVITY_NOTIFY:    return sizeof(XGravityEvent);
+		case EventType::RESIZE_REQUEST:    return sizeof(XResizeRequestEvent);
+		case EventType::CIRCULATE_NOTIFY:  return sizeof(XCirculateEvent);
+		case EventType::CIRCULATE_REQUEST: return sizeof(XCirculateRequestEvent);
+		case EventType::PROPERTY_NOTIFY:   return sizeof(XPropertyEvent);
+		case EventType::SELECTION_CLEAR:   return sizeof(XSelectionClearEvent);
+		case EventType::SELECTION_REQUEST: return sizeof(XSelectionRequestEvent);
+		case EventType::SELECTION_NOTIFY:  return sizeof(XSelectionEvent);
+		case EventType::COLORMAP_NOTIFY:   return sizeof(XColormapEvent);
+		case EventType::CLIENT_MESSAGE:    return sizeof(XClientMessageEvent);
+		case EventType::MAPPING_NOTIFY:    return sizeof(XMappingEvent);
+		default:                           return sizeof(XEvent);
+	}
+}
+
+EventRecorder::EventRecorder(const std::string &path) :
+		m_file{path, std::ios::binary | std::ios::trunc},
+		m_start{std::chrono::steady_clock::now()} {
+	if (!m_file) {
+		throw cosmos::RuntimeError{"failed to create event recording"};
+	}
+
+	FileHeader header{};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.event_size = sizeof(XEvent);
+
+	m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void EventRecorder::record(const Event &event) {
+	record(event, std::chrono::steady_clock::now() - m_start);
+}
+
+void EventRecorder::record(const Event &event, const std::chrono::nanoseconds offset) {
+	const RecordHeader header{
+		static_cast<uint64_t>(offset.count()),
+		cosmos::to_integral(event.type()),
+		static_cast<uint16_t>(event_data_size(event.type()))
+	};
+
+	m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	m_file.write(reinterpret_cast<const char*>(event.raw()), header.size);
+
+	if (!m_file) {
+		throw cosmos::RuntimeError{"failed to write event recording"};
+	}
+
+	m_num_events++;
+}
+
+void EventRecorder::flush() {
+	m_file.flush();
+}
+
+EventReplay::EventReplay(const std::string &path) :
+		m_file{path, std::ios::binary} {
+	FileHeader header{};
+
+	if (!m_file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+		throw cosmos::RuntimeError{"failed to read event recording header"};
+	} else if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+			header.version != VERSION ||
+			header.event_size != sizeof(XEvent)) {
+		throw cosmos::RuntimeError{"unsupported event recording format"};
+	}
+
+	m_data_start = m_file.tellg();
+}
+
+bool EventReplay::next(Event &event, std::chrono::nanoseconds &offset) {
+	RecordHeader header;
+
+	if (!m_file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+		return false;
+	} else if (header.size > sizeof(XEvent)) {
+		throw cosmos::RuntimeError{"corrupt event recording"};
+	}
+
+	auto raw = event.raw();
+	std::memset(raw, 0, sizeof(XEvent));
+
+	if (!m_file.read(reinterpret_cast<char*>(raw), header.size)) {
+		throw cosmos::RuntimeError{"truncated event recording"};
+	}
+
+	raw->xany.display = nullptr;
+	offset = std::chrono::nanoseconds{header.offset_ns};
+	return true;
+}
+
+size_t EventReplay::replay(const Sink &sink, const Timing timing) {
+	const auto start = std::chrono::steady_clock::now();
+	std::chrono::nanoseconds offset;
+	Event event;
+	size_t ret = 0;
+
+	while (next(event, offset)) {
+		if (timing == Timing::ORIGINAL) {
+			std::this_thread::sleep_until(start + offset);
+		}
+
+		sink(event);
+		ret++;
+	}
+
+	return ret;
+}
+
+void EventReplay::rewind() {
+	m_file.clear();
+	m_file.seekg(m_data_start);
+}
+
+} // end ns
@@ -0,0 +1,318 @@
+// C
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+// C++
+#include <algorithm>
+#include <cstring>
+
+// X11
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+
+// cosmos
+#include <cosmos/error/RuntimeError.hxx>
+#include <cosmos/error/UsageError.hxx>
+
+// xpp
+#include <xpp/GraphicsContext.hxx>
+#include <xpp/helpers.hxx>
+#include <xpp/Image.hxx>
+#include <xpp/Pixmap.hxx>
+#include <xpp/private/errors.hxx>
+#include <xpp/private/instrument.hxx>
+#include <xpp/private/xcb.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/X11Exception.hxx>
+#include <xpp/XWindow.hxx>
+
+namespace xpp {
+
+struct Image::ShmSegment : XShmSegmentInfo {
+	ShmSegment() : XShmSegmentInfo{} {
+		shmid = -1;
+	}
+};
+
+Image::Image() = default;
+
+Image::Image(Image &&other) noexcept {
+	*this = std::move(other);
+}
+
+Image::Image(const Extent extent, const UseShm use_shm, XDisplay &disp) :
+		m_display{&disp} {
+
+	if (use_shm && ::XShmQueryExtension(disp) && createShared(extent)) {
+		return;
+	}
+
+	createPlain(extent);
+}
+
+Image& Image::operator=(Image &&other) noexcept {
+	if (this == &other)
+		return *this;
+
+	destroy();
+
+	m_display = other.m_display;
+	m_image = other.m_image;
+	m_shm = std::move(other.m_shm);
+	m_buffer = std::move(other.m_buffer);
+	m_catcher = std::move(other.m_catcher);
+	m_last_put = other.m_last_put;
+
+	other.m_display = nullptr;
+	other.m_image = nullptr;
+	other.m_last_put = RequestToken{};
+	return *this;
+}
+
+Image::~Image() {
+	destroy();
+}
+
+bool Image::createShared(const Extent extent) {
+	auto &disp = *m_display;
+	auto shm = std::make_unique<ShmSegment>();
+
+	// the XImage keeps a pointer to the segment info, thus it needs to
+	// live on the heap to survive moves of the Image object
+	auto image = ::XShmCreateImage(
+		disp, disp.defaultVisual(), disp.defaultDepth(), ZPixmap,
+		nullptr, shm.get(), extent.width, extent.height);
+
+	if (!image) {
+		return false;
+	}
+
+	auto discard_image = [image]() {
+		// the data is not owned by the XImage, don't let Xlib free it
+		image->data = nullptr;
+		XDestroyImage(image);
+	};
+
+	shm->shmid = ::shmget(IPC_PRIVATE,
+			size_t(image->bytes_per_line) * image->height, IPC_CREAT | 0600);
+
+	if (shm->shmid == -1) {
+		discard_image();
+		return false;
+	}
+
+	shm->shmaddr = image->data = static_cast<char*>(::shmat(shm->shmid, nullptr, 0));
+
+	if (shm->shmaddr == reinterpret_cast<char*>(-1)) {
+		::shmctl(shm->shmid, IPC_RMID, nullptr);
+		discard_image();
+		return false;
+	}
+
+	shm->readOnly = False;
+
+	/*
+	 * Attaching fails asynchronously if the server can't access the
+	 * segment, e.g. for remote connections, so synchronize and look out
+	 * for errors.
+	 */
+	auto catcher = std::make_unique<errors::RequestCatcher>(disp);
+	bool attach_failed = false;
+
+	try {
+		catcher->expect(disp.nextRequest());
+		::XShmAttach(disp, shm.get());
+		disp.sync();
+		attach_failed = catcher->finish() != Success;
+	} catch (...) {
+		catcher->finish();
+		attach_failed = true;
+	}
+
+	// the segment is now kept alive by the attached processes only, no
+	// matter how we terminate
+	::shmctl(shm->shmid, IPC_RMID, nullptr);
+
+	if (attach_failed) {
+		::shmdt(shm->shmaddr);
+		discard_image();
+		return false;
+	}
+
+	m_image = image;
+	m_shm = std::move(shm);
+	// keep the error sink registered for all future getImage() calls
+	m_catcher = std::move(catcher);
+	return true;
+}
+
+void Image::createPlain(const Extent extent) {
+	auto &disp = *m_display;
+
+	auto image = ::XCreateImage(
+		disp, disp.defaultVisual(), disp.defaultDepth(), ZPixmap,
+		0, nullptr, extent.width, extent.height,
+		/* bitmap_pad = */ 32, /* bytes_per_line = (auto) */ 0);
+
+	if (!image) {
+		cosmos_throw (cosmos::RuntimeError("failed to create XImage"));
+	}
+
+	m_buffer.resize(size_t(image->bytes_per_line) * image->height);
+	image->data = reinterpret_cast<char*>(m_buffer.data());
+	m_image = image;
+}
+
+RequestToken Image::putImage(const DrawableID target, const GraphicsContext &gc,
+		const Coord dst, const std::optional<WindowSpec> area) {
+	if (!valid()) {
+		cosmos_throw (cosmos::UsageError("putImage() on invalid Image"));
+	}
+
+	const auto src = area ? *area : WindowSpec{0, 0,
+		static_cast<unsigned>(m_image->width),
+		static_cast<unsigned>(m_image->height)};
+
+	XPP_MEASURE(*m_display, "Image::putImage");
+	const auto first = m_display->nextRequest();
+
+	if (m_shm) {
+		// no completion event is requested, see waitIdle()
+		(void)::XShmPutImage(
+			*m_display, cosmos::to_integral(target), gc, m_image,
+			src.x, src.y, dst.x, dst.y, src.width, src.height, False);
+	} else {
+		XPP_COUNT_BYTES_SENT(*m_display, size_t(src.height) * bytesPerLine());
+		// does not return synchronous errors
+		(void)::XPutImage(
+			*m_display, cosmos::to_integral(target), gc, m_image,
+			src.x, src.y, dst.x, dst.y, src.width, src.height);
+	}
+
+	m_last_put = RequestToken{*m_display, first};
+	return m_last_put;
+}
+
+RequestToken Image::putImage(const Pixmap &target, const GraphicsContext &gc,
+		const Coord dst, const std::optional<WindowSpec> area) {
+	return putImage(to_drawable(target.id()), gc, dst, area);
+}
+
+RequestToken Image::putImage(const XWindow &target, const GraphicsContext &gc,
+		const Coord dst, const std::optional<WindowSpec> area) {
+	return putImage(to_drawable(target.id()), gc, dst, area);
+}
+
+void Image::getImage(const DrawableID source, const Coord src) {
+	if (!valid()) {
+		cosmos_throw (cosmos::UsageError("getImage() on invalid Image"));
+	}
+
+	XPP_MEASURE(*m_display, "Image::getImage");
+	XPP_COUNT_ROUND_TRIP(*m_display);
+
+	if (m_shm) {
+		m_catcher->expect(m_display->nextRequest());
+		const bool ok = ::XShmGetImage(
+				*m_display, cosmos::to_integral(source), m_image,
+				src.x, src.y, AllPlanes);
+		const auto error = m_catcher->finish();
+
+		if (error != Success) {
+			throw X11Exception{*m_display, error};
+		} else if (!ok) {
+			cosmos_throw (cosmos::RuntimeError("failed to get image data"));
+		}
+	} else {
+		getPlainImage(source, src);
+	}
+}
+
+void Image::getPlainImage(const DrawableID source, const Coord src) {
+	/*
+	 * XGetSubImage() allocates a temporary XImage for every call and
+	 * converts its data into ours. Via XCB the pixel data is copied from
+	 * the reply buffer right away instead.
+	 */
+	auto conn = xcb_connection(*m_display);
+	const auto height = static_cast<size_t>(m_image->height);
+
+	if (height == 0 || m_image->width == 0)
+		return;
+
+	const auto cookie = ::xcb_get_image(conn, XCB_IMAGE_FORMAT_Z_PIXMAP,
+			cosmos::to_integral(source),
+			static_cast<int16_t>(src.x), static_cast<int16_t>(src.y),
+			static_cast<uint16_t>(m_image->width), static_cast<uint16_t>(m_image->height),
+			~uint32_t{0});
+
+	xcb_generic_error_t *error = nullptr;
+	XcbPtr<xcb_get_image_reply_t> reply{::xcb_get_image_reply(conn, cookie, &error)};
+	XcbPtr<xcb_generic_error_t> error_guard{error};
+
+	if (!reply) {
+		if (error) {
+			throw X11Exception{*m_display, error->error_code};
+		}
+		cosmos_throw (cosmos::RuntimeError("failed to get image data"));
+	}
+
+	const auto data = ::xcb_get_image_data(reply.get());
+	const auto length = static_cast<size_t>(::xcb_get_image_data_length(reply.get()));
+	const auto stride = length / height;
+	const auto line = bytesPerLine();
+
+	if (reply->depth != m_image->depth || stride * height != length) {
+		cosmos_throw (cosmos::RuntimeError("unexpected image data layout"));
+	}
+
+	XPP_COUNT_BYTES_RECEIVED(*m_display, length);
+
+	if (stride == line) {
+		std::memcpy(m_buffer.data(), data, length);
+		return;
+	}
+
+	// the server pads its scanlines differently than we do
+	const auto copy = std::min(stride, line);
+
+	for (size_t y = 0; y < height; y++) {
+		std::memcpy(m_buffer.data() + y * line, data + y * stride, copy);
+	}
+}
+
+void Image::getImage(const XWindow &source, const Coord src) {
+	getImage(to_drawable(source.id()), src);
+}
+
+void Image::waitIdle() {
+	if (m_shm && m_last_put.valid() && !m_last_put.processed()) {
+		m_display->sync();
+	}
+}
+
+void Image::destroy() {
+	if (!valid())
+		return;
+
+	if (m_shm) {
+		// the server keeps its own mapping until the detach request is
+		// processed, thus we can unmap right away
+		::XShmDetach(*m_display, m_shm.get());
+		::shmdt(m_shm->shmaddr);
+		m_shm.reset();
+		m_catcher.reset();
+	} else {
+		m_buffer.clear();
+	}
+
+	// the data is not owned by the XImage, don't let Xlib free it
+	m_image->data = nullptr;
+	XDestroyImage(m_image);
+	m_image = nullptr;
+	m_display = nullptr;
+	m_last_put = RequestToken{};
+}
+
+} // end ns
@@ -0,0 +1,238 @@
+// C++
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <vector>
+
+// cosmos
+#include <cosmos/thread/Mutex.hxx>
+
+// xpp
+#include <xpp/Instrumentation.hxx>
+#include <xpp/private/instrument.hxx>
+#include <xpp/private/Xpp.hxx>
+#include <xpp/XDisplay.hxx>
+
+namespace xpp {
+
+uint64_t LatencyHistogram::percentile(const unsigned pct) const {
+	if (calls == 0)
+		return 0;
+
+	const auto rank = (pct * calls + 99) / 100;
+	uint64_t seen = 0;
+
+	for (size_t bucket = 0; bucket < BUCKETS - 1; bucket++) {
+		seen += buckets[bucket];
+		if (seen >= rank)
+			return uint64_t{1} << (bucket + 1);
+	}
+
+	return max_ns;
+}
+
+#ifdef XPP_INSTRUMENT
+
+namespace instr {
+
+namespace {
+
+	struct Registry {
+		cosmos::Mutex lock;
+		std::vector<Site*> sites;
+		std::vector<std::unique_ptr<DisplayCounters>> displays;
+	};
+
+	Registry& registry() {
+		static Registry reg;
+		return reg;
+	}
+
+	void update_max(std::atomic<uint64_t> &max, const uint64_t val) {
+		auto prev = max.load(std::memory_order_relaxed);
+		while (prev < val && !max.compare_exchange_weak(prev, val, std::memory_order_relaxed)) {
+			;
+		}
+	}
+
+} // end anon ns
+
+DisplayCounters& counters_for(const XDisplay &disp) {
+	// fast path: counting an event must not serialize all threads
+	if (auto cached = disp.m_instr_counters.load(std::memory_order_acquire); cached) {
+		return *cached;
+	}
+
+	auto &reg = registry();
+	cosmos::MutexGuard g{reg.lock};
+	Display *dis = disp.m_dis;
+
+	// the display may have been looked up concurrently in the meantime
+	for (auto &counters: reg.displays) {
+		if (counters->dis == dis) {
+			disp.m_instr_counters.store(counters.get(), std::memory_order_release);
+			return *counters;
+		}
+	}
+
+	auto &ret = reg.displays.emplace_back(std::make_unique<DisplayCounters>());
+	ret->dis = dis;
+	ret->request_base = ::XNextRequest(dis);
+	disp.m_instr_counters.store(ret.get(), std::memory_order_release);
+	return *ret;
+}
+
+Site::Site(const char *_name) :
+		name{_name} {
+	auto &reg = registry();
+	cosmos::MutexGuard g{reg.lock};
+	reg.sites.push_back(this);
+}
+
+void Site::record(const uint64_t ns, const uint64_t num_requests) {
+	// floor(log2(ns)), calls below 1 ns end up in the first bucket
+	const size_t bucket = ns ? std::bit_width(ns) - 1 : 0;
+	buckets[std::min(bucket, buckets.size() - 1)].fetch_add(1, std::memory_order_relaxed);
+	calls.fetch_add(1, std::memory_order_relaxed);
+	requests.fetch_add(num_requests, std::memory_order_relaxed);
+	total_ns.fetch_add(ns, std::memory_order_relaxed);
+	update_max(max_ns, ns);
+}
+
+void count_round_trip(const XDisplay &disp) {
+	counters_for(disp).round_trips.fetch_add(1, std::memory_order_relaxed);
+}
+
+void count_flush(const XDisplay &disp) {
+	counters_for(disp).flushes.fetch_add(1, std::memory_order_relaxed);
+}
+
+void count_bytes_sent(const XDisplay &disp, const size_t bytes) {
+	counters_for(disp).bytes_sent.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void count_bytes_received(const XDisplay &disp, const size_t bytes) {
+	counters_for(disp).bytes_received.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void forget(Display *dis) {
+	auto &reg = registry();
+	cosmos::MutexGuard g{reg.lock};
+
+	std::erase_if(reg.displays, [dis](const auto &counters) {
+		return counters->dis == dis;
+	});
+}
+
+} // end ns instr
+
+#endif // XPP_INSTRUMENT
+
+namespace instrumentation {
+
+bool enabled() {
+#ifdef XPP_INSTRUMENT
+	return true;
+#else
+	return false;
+#endif
+}
+
+RequestCounters counters([[maybe_unused]] XDisplay &disp) {
+	RequestCounters ret;
+#ifdef XPP_INSTRUMENT
+	Display *dis = disp;
+	const auto &counters = instr::counters_for(disp);
+	ret.requests = ::XNextRequest(dis) - counters.request_base;
+	ret.round_trips = counters.round_trips.load();
+	ret.flushes = counters.flushes.load();
+	ret.bytes_sent = counters.bytes_sent.load();
+	ret.bytes_received = counters.bytes_received.load();
+#endif
+	return ret;
+}
+
+LatencyTable latencies() {
+	LatencyTable ret;
+#ifdef XPP_INSTRUMENT
+	auto &reg = instr::registry();
+	cosmos::MutexGuard g{reg.lock};
+
+	// template functions have one site per instantiation, these are
+	// merged by name
+	for (const auto site: reg.sites) {
+		auto &hist = ret[site->name];
+
+		for (size_t bucket = 0; bucket < hist.buckets.size(); bucket++) {
+			hist.buckets[bucket] += site->buckets[bucket].load();
+		}
+
+		hist.calls += site->calls.load();
+		hist.requests += site->requests.load();
+		hist.total_ns += site->total_ns.load();
+		hist.max_ns = std::max(hist.max_ns, site->max_ns.load());
+	}
+#endif
+	return ret;
+}
+
+void reset() {
+#ifdef XPP_INSTRUMENT
+	auto &reg = instr::registry();
+	cosmos::MutexGuard g{reg.lock};
+
+	for (auto site: reg.sites) {
+		for (auto &bucket: site->buckets) {
+			bucket = 0;
+		}
+
+		site->calls = 0;
+		site->requests = 0;
+		site->total_ns = 0;
+		site->max_ns = 0;
+	}
+
+	for (auto &counters: reg.displays) {
+		counters->request_base = ::XNextRequest(counters->dis);
+		counters->round_trips = 0;
+		counters->flushes = 0;
+		counters->bytes_sent = 0;
+		counters->bytes_received = 0;
+	}
+#endif
+}
+
+void dump(XDisplay &disp) {
+	if (!enabled())
+		return;
+
+	auto &logger = Xpp::getLogger();
+	const auto cnt = counters(disp);
+
+	logger.info() << "X protocol counters: " << cnt.requests << " requests, "
+		<< cnt.round_trips << " round trips, "
+		<< cnt.flushes << " flushes, "
+		<< cnt.bytes_sent << " bytes sent, "
+		<< cnt.bytes_received << " bytes received\n";
+
+	for (const auto &[name, hist]: latencies()) {
+		if (hist.calls == 0)
+			continue;
+
+		logger.info() << "- " << name << ": " << hist.calls << " calls, "
+			<< hist.requests << " requests, mean "
+			<< static_cast<uint64_t>(hist.mean()) << " ns, p50 <= "
+			<< hist.percentile(50) << " ns, p99 <= "
+			<< hist.percentile(99) << " ns, max "
+			<< hist.max_ns << " ns\n";
+	}
+}
+
+EventLoop::TimerID dump_periodically(EventLoop &loop, XDisplay &disp,
+		const std::chrono::milliseconds interval) {
+	return loop.addTimer(interval, [&disp]() { dump(disp); }, interval);
+}
+
+} // end ns instrumentation
+
+} // end ns
@@ -16,7 +16,7 @@ Pixmap::Pixmap(
 
 	auto pm = ::XCreatePixmap(
 			disp, raw_win(win), extent.width, extent.height,
-			depth ? *depth : display.defaultDepth());
+			depth ? *depth : disp.defaultDepth());
 
 	m_display = &disp;
 	m_id = PixmapID{pm};
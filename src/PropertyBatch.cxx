@@ -0,0 +1,77 @@
+// C++
+#include <vector>
+
+// xpp
+#include <xpp/helpers.hxx>
+#include <xpp/PropertyBatch.hxx>
+#include <xpp/private/instrument.hxx>
+#include <xpp/private/xcb.hxx>
+#include <xpp/XDisplay.hxx>
+
+namespace xpp {
+
+void PropertyBatch::fetch() {
+	auto conn = xcb_connection(*m_display);
+	std::vector<xcb_get_property_cookie_t> cookies;
+	cookies.reserve(m_items.size());
+
+	// first send out all requests ...
+	for (auto &item: m_items) {
+		item.status = PropertyStatus::PENDING;
+
+		cookies.push_back(::xcb_get_property(
+			conn,
+			/* delete = */ 0,
+			raw_win(item.win),
+			raw_atom(item.property),
+			raw_atom(item.type),
+			/* offset = */ 0,
+			/* length in 32-bit multiples */
+			static_cast<uint32_t>((item.max_len + 3) / 4)));
+	}
+
+	// ... then collect the replies, only the first one will actually
+	// have to wait for the server.
+	for (size_t num = 0; num < m_items.size(); num++) {
+		auto &item = m_items[num];
+		xcb_generic_error_t *error = nullptr;
+		XPP_COUNT_ROUND_TRIP(*m_display);
+		XcbPtr<xcb_get_property_reply_t> reply{
+			::xcb_get_property_reply(conn, cookies[num], &error)};
+		XcbPtr<xcb_generic_error_t> error_guard{error};
+
+		if (!reply) {
+			item.status = PropertyStatus::QUERY_ERROR;
+			continue;
+		}
+
+		process(item, reply.get());
+	}
+}
+
+void PropertyBatch::process(Item &item, xcb_get_property_reply_t *reply) {
+	if (reply->type == XCB_NONE) {
+		item.status = PropertyStatus::NOT_EXISTING;
+		return;
+	} else if (AtomID{reply->type} != item.type || reply->format != item.format) {
+		item.status = PropertyStatus::TYPE_MISMATCH;
+		return;
+	} else if (reply->bytes_after != 0) {
+		item.status = PropertyStatus::TRUNCATED;
+		return;
+	}
+
+	unsigned long size = 0;
+	auto data = to_xlib_property_data(reply, size);
+
+	try {
+		item.decode(item.prop, data, size);
+	} catch (...) {
+		::free(data);
+		throw;
+	}
+
+	item.status = PropertyStatus::OK;
+}
+
+} // end ns
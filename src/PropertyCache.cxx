@@ -0,0 +1,92 @@
+// xpp
+#include <xpp/Event.hxx>
+#include <xpp/event/DestroyEvent.hxx>
+#include <xpp/event/PropertyEvent.hxx>
+#include <xpp/PropertyCache.hxx>
+
+namespace xpp {
+
+bool PropertyCache::processEvent(const Event &event) {
+	switch (event.type()) {
+		case EventType::PROPERTY_NOTIFY: {
+			const PropertyEvent prop{event};
+			if (auto win = prop.window(); win) {
+				invalidate(*win, prop.property());
+			}
+			return true;
+		}
+		case EventType::DESTROY_NOTIFY: {
+			const auto win = DestroyEvent{event}.window();
+			invalidate(win);
+			m_watched.erase(win);
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+void PropertyCache::invalidate(const WinID win, const AtomID property) {
+	if (auto it = m_entries.find(Key{win, property}); it != m_entries.end()) {
+		erase(it);
+		m_stats.invalidations++;
+	}
+}
+
+void PropertyCache::invalidate(const WinID win) {
+	for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+		auto next = std::next(it);
+		if (it->first.win == win) {
+			erase(it);
+			m_stats.invalidations++;
+		}
+		it = next;
+	}
+}
+
+void PropertyCache::clear() {
+	m_entries.clear();
+	m_lru.clear();
+	m_bytes = 0;
+}
+
+void PropertyCache::setMaxBytes(const size_t max_bytes) {
+	m_max_bytes = max_bytes;
+	shrink();
+}
+
+void PropertyCache::watch(const XWindow &win) {
+	if (!m_select_events)
+		return;
+
+	if (m_watched.insert(win.id()).second) {
+		// DestroyNotify is needed to drop entries of destroyed windows,
+		// otherwise they'd be served again once the WinID is reused
+		win.mergeEventSelection(EventSelectionMask{
+				EventMask::PROPERTY_CHANGE, EventMask::STRUCTURE_NOTIFY});
+	}
+}
+
+void PropertyCache::insert(const Key &key, std::unique_ptr<ValueBase> value) {
+	m_lru.push_front(key);
+	m_bytes += value->bytes;
+	m_entries[key] = Entry{std::move(value), m_lru.begin()};
+	shrink();
+}
+
+void PropertyCache::erase(EntryMap::iterator it) {
+	m_bytes -= it->second.value->bytes;
+	m_lru.erase(it->second.lru_pos);
+	m_entries.erase(it);
+}
+
+void PropertyCache::shrink() {
+	// never evict the most recently used entry, a reference to it might
+	// just have been handed out by get().
+	while (m_bytes > m_max_bytes && m_lru.size() > 1) {
+		erase(m_entries.find(m_lru.back()));
+		m_stats.evictions++;
+	}
+}
+
+} // end ns
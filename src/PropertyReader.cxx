@@ -0,0 +1,137 @@
+// C++
+#include <algorithm>
+#include <map>
+#include <utility>
+
+// cosmos
+#include <cosmos/error/RuntimeError.hxx>
+#include <cosmos/thread/Mutex.hxx>
+
+// xpp
+#include <xpp/helpers.hxx>
+#include <xpp/PropertyReader.hxx>
+#include <xpp/private/instrument.hxx>
+#include <xpp/private/xcb.hxx>
+
+namespace xpp {
+
+namespace {
+
+	/// Property sizes observed in earlier reads, per display and property atom.
+	/**
+	 * Atom IDs are only meaningful on the connection they have been
+	 * obtained from. Entries of closed displays are not cleaned up, they
+	 * can only lead to a less suitable first read request.
+	 **/
+	std::map<std::pair<Display*, AtomID>, size_t> g_size_hints;
+	cosmos::Mutex g_size_hints_lock;
+
+	size_t get_size_hint(XDisplay &disp, const AtomID property) {
+		cosmos::MutexGuard g{g_size_hints_lock};
+		auto it = g_size_hints.find({disp, property});
+		return it == g_size_hints.end() ? 0 : it->second;
+	}
+
+	void set_size_hint(XDisplay &disp, const AtomID property, const size_t bytes) {
+		cosmos::MutexGuard g{g_size_hints_lock};
+		g_size_hints[{disp, property}] = bytes;
+	}
+
+} // end anon ns
+
+PropertyReader::PropertyReader(const XWindow &win, const AtomID property,
+		const size_t chunk_size, const size_t read_ahead,
+		const XWindow::PropertyInfo *info) :
+			m_display{win.getDisplay()},
+			m_win{win.id()},
+			m_property{property},
+			m_chunk_size{std::max<size_t>((chunk_size + 3) & ~size_t{3}, 4)},
+			m_read_ahead{std::max<size_t>(read_ahead, 1)} {
+
+	const size_t hint = info ? info->numBytes() : get_size_hint(m_display, property);
+
+	// if the expected size fits into the read-ahead window then get it in
+	// one go, otherwise start with a regular chunk.
+	size_t first = m_chunk_size;
+	if (hint > first && hint <= m_chunk_size * m_read_ahead) {
+		first = (hint + 3) & ~size_t{3};
+	}
+
+	request(0, first);
+}
+
+PropertyReader::~PropertyReader() {
+	auto conn = xcb_connection(m_display);
+
+	for (const auto &req: m_pending) {
+		::xcb_discard_reply(conn, req.sequence);
+	}
+}
+
+void PropertyReader::request(const size_t offset, const size_t length) {
+	auto conn = xcb_connection(m_display);
+
+	// offset and length are specified in 32-bit units
+	auto cookie = ::xcb_get_property(conn, 0, raw_win(m_win), raw_atom(m_property),
+			XCB_GET_PROPERTY_TYPE_ANY, offset / 4, length / 4);
+
+	m_pending.push_back(Request{cookie.sequence, offset});
+	m_next_offset = offset + length;
+}
+
+void PropertyReader::fillPipeline() {
+	while (m_pending.size() < m_read_ahead && m_next_offset < m_total) {
+		request(m_next_offset, std::min(m_chunk_size, m_total - m_next_offset + 3) & ~size_t{3});
+	}
+}
+
+bool PropertyReader::next(RawProperty &chunk) {
+	if (m_pending.empty())
+		return false;
+
+	auto conn = xcb_connection(m_display);
+	const auto req = m_pending.front();
+	m_pending.pop_front();
+
+	xcb_generic_error_t *error = nullptr;
+	XPP_COUNT_ROUND_TRIP(m_display);
+	std::shared_ptr<xcb_get_property_reply_t> reply{
+		::xcb_get_property_reply(conn, xcb_get_property_cookie_t{req.sequence}, &error),
+		XcbDeleter{}};
+	XcbPtr<xcb_generic_error_t> error_guard{error};
+
+	if (!reply) {
+		throw XWindow::PropertyQueryError{m_display, error ? error->error_code : BadImplementation};
+	}
+
+	const size_t length = ::xcb_get_property_value_length(reply.get());
+
+	if (!m_have_info) {
+		m_type = AtomID{reply->type};
+
+		if (m_type == AtomID::INVALID) {
+			throw XWindow::PropertyNotExisting{};
+		}
+
+		m_format = reply->format;
+		m_total = length + reply->bytes_after;
+		m_have_info = true;
+		set_size_hint(m_display, m_property, m_total);
+	} else if (AtomID{reply->type} != m_type || req.offset + length + reply->bytes_after != m_total) {
+		throw cosmos::RuntimeError{"property changed while being read"};
+	}
+
+	// share ownership of the reply with the returned data
+	auto value = static_cast<uint8_t*>(::xcb_get_property_value(reply.get()));
+	chunk.data = std::shared_ptr<uint8_t>{reply, value};
+	chunk.length = length;
+	chunk.offset = req.offset;
+	chunk.left = reply->bytes_after;
+	m_read += length;
+
+	fillPipeline();
+
+	return true;
+}
+
+} // end ns
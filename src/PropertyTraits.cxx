@@ -1,9 +1,11 @@
 // xpp
 #include <xpp/PropertyTraits.hxx>
+#include <xpp/PropertyView.hxx>
 
 namespace xpp {
 
 AtomID PropertyTraits<utf8_string>::x_type = AtomID::INVALID;
 AtomID PropertyTraits<std::vector<utf8_string>>::x_type = AtomID::INVALID;
+AtomID PropertyTraits<PropertyView<utf8_string>>::x_type = AtomID::INVALID;
 
 } // end ns
@@ -0,0 +1,89 @@
+// C++
+#include <exception>
+
+// xpp
+#include <xpp/private/errors.hxx>
+#include <xpp/private/Xpp.hxx>
+#include <xpp/RequestBatch.hxx>
+#include <xpp/X11Exception.hxx>
+
+namespace xpp {
+
+RequestBatch::RequestBatch(XDisplay &disp, const CheckErrors check) :
+		m_display{disp},
+		m_check{check} {
+	m_display.m_batch_depth++;
+
+	if (m_check) {
+		m_first_serial = ::XNextRequest(m_display);
+		registerChecking();
+	}
+}
+
+RequestBatch::~RequestBatch() {
+	try {
+		finish();
+	} catch (const std::exception &ex) {
+		Xpp::getLogger().warn() << "Error ending request batch: " << ex.what() << std::endl;
+	}
+}
+
+void RequestBatch::finish() {
+	if (m_finished)
+		return;
+
+	m_finished = true;
+	const auto depth = --m_display.m_batch_depth;
+
+	if (!m_check) {
+		if (depth == 0) {
+			m_display.flush();
+		}
+		return;
+	}
+
+	// requests issued from now on, e.g. by other threads, don't belong
+	// to the batch anymore
+	m_last_serial = ::XNextRequest(m_display) - 1;
+
+	try {
+		// errors for all of our requests have been received once this
+		// returns
+		m_display.sync();
+	} catch (...) {
+		unregisterChecking();
+		throw;
+	}
+
+	unregisterChecking();
+
+	if (m_first_error) {
+		throw X11Exception{m_display, m_first_error->error_code};
+	}
+}
+
+void RequestBatch::registerChecking() {
+	m_sink = errors::add_sink([this](Display *dis, const XErrorEvent &ev) {
+		return recordError(dis, ev);
+	});
+}
+
+void RequestBatch::unregisterChecking() {
+	errors::remove_sink(m_sink);
+	m_sink = 0;
+}
+
+bool RequestBatch::recordError(Display *dis, const XErrorEvent &ev) {
+	// every batch that was active when the failed request was issued
+	// receives the error, including enclosing batches
+	if (m_display != dis || ev.serial < m_first_serial || ev.serial > m_last_serial)
+		return false;
+
+	if (!m_first_error) {
+		m_first_error = ev;
+	}
+	m_num_errors++;
+	return true;
+}
+
+} // end ns
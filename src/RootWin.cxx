@@ -2,6 +2,8 @@
 #include <xpp/atoms.hxx>
 #include <xpp/formatting.hxx>
 #include <xpp/helpers.hxx>
+#include <xpp/private/instrument.hxx>
+#include <xpp/private/xcb.hxx>
 #include <xpp/private/Xpp.hxx>
 #include <xpp/Property.hxx>
 #include <xpp/RootWin.hxx>
@@ -9,11 +11,11 @@
 namespace xpp {
 
 RootWin::RootWin(XDisplay &_display, ScreenID _screen) :
-		XWindow{WinID{
-			::XRootWindow(_display,
-					raw_screen(_screen != ScreenID::INVALID ?
-						_screen :
-						_display.defaultScreen()))}} {
+		XWindow{
+			_display.rootWindow(_screen != ScreenID::INVALID ?
+				_screen :
+				_display.defaultScreen()),
+			_display} {
 
 	Xpp::getLogger().debug() << "root window has id: " << *this << "\n";
 
@@ -29,7 +31,7 @@ RootWin::RootWin(XDisplay &_display, ScreenID _screen) :
 }
 
 RootWin::RootWin() :
-		RootWin{display, display.defaultScreen()}
+		RootWin{xpp::display, xpp::display.defaultScreen()}
 {}
 
 void RootWin::queryWindows() {
@@ -78,66 +80,57 @@ void RootWin::queryTree() {
 	 * there could be a possibility to lock the complete X server for the
 	 * duration of this operation but I didn't look that up yet ...
 	 */
+	auto conn = xcb_connection(getDisplay());
 
-	// helper class for storing tree traversal state
-	class TreeNode :
-			public XWindow {
-	public:
-		explicit TreeNode(WinID w) : XWindow{w} {
-			// query all children
-			updateFamily();
-			m_next = m_children.begin();
-		}
+	m_tree.clear();
+	m_parents.clear();
 
-		TreeNode(const TreeNode &o) = delete;
+	// the windows of the current tree level
+	std::vector<WinID> level{this->id()};
+	std::vector<WinID> next_level;
+	std::vector<xcb_query_tree_cookie_t> cookies;
 
-		bool isFinished() const { return m_next == m_children.end(); }
-		void nextChild() { m_next++; }
-		WinID currentChild() { return *m_next; }
+	while (!level.empty()) {
+		cookies.clear();
+		next_level.clear();
 
-		// next child to process
-		WindowSet::const_iterator m_next;
-	};
+		for (const auto win: level) {
+			cookies.push_back(::xcb_query_tree(conn, raw_win(win)));
+		}
 
-	m_tree.clear();
+		for (size_t num = 0; num < level.size(); num++) {
+			const auto win = level[num];
+			xcb_generic_error_t *error = nullptr;
+			XPP_COUNT_ROUND_TRIP(getDisplay());
+			XcbPtr<xcb_query_tree_reply_t> reply{
+				::xcb_query_tree_reply(conn, cookies[num], &error)};
+			XcbPtr<xcb_generic_error_t> error_guard{error};
+
+			if (!reply) {
+				if (win == this->id()) {
+					Xpp::getLogger().warn() << "Couldn't query window tree of root window\n";
+					throw QueryError{"failed to query root window tree"};
+				}
+
+				// the window vanished in the meantime
+				Xpp::getLogger().debug() << "skipping vanished window " << win << " in queryTree()\n";
+				m_parents.erase(win);
+				continue;
+			}
 
-	// Use heap allocated node instances, otherwise the copying
-	// within containers becomes troublesome. Using C++11
-	// movables there might be a more efficient and elegant
-	// approach
-	std::vector<TreeNode*> to_process;
+			m_tree.push_back(win);
 
-	try {
+			const auto children = ::xcb_query_tree_children(reply.get());
+			const auto num_children = ::xcb_query_tree_children_length(reply.get());
 
-		// start with the root window
-		to_process.push_back(new TreeNode{this->id()});
-
-		while (!to_process.empty()) {
-			auto &current = *(to_process.back());
-
-			if (current.isFinished()) {
-				// no more children, add this window to the
-				// list and remove it
-				m_tree.push_back(WinID{current.id()});
-				delete &current;
-				to_process.pop_back();
-			} else {
-				// add the next child to the list to process
-				// and select the next child window for the
-				// currently processed one
-				auto next = current.currentChild();
-				current.nextChild();
-
-				to_process.push_back(new TreeNode{next});
+			for (int child = 0; child < num_children; child++) {
+				const WinID child_id{children[child]};
+				m_parents[child_id] = win;
+				next_level.push_back(child_id);
 			}
 		}
-	} catch (const cosmos::CosmosError &ex) {
-		Xpp::getLogger().warn() << "Couldn't query window tree: " << ex.what();
-		while (!to_process.empty()) {
-			delete to_process.back();
-			to_process.pop_back();
-		}
-		throw;
+
+		std::swap(level, next_level);
 	}
 }
 
@@ -0,0 +1,108 @@
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/Event.hxx>
+#include <xpp/event/PropertyEvent.hxx>
+#include <xpp/event/SelectionEvent.hxx>
+#include <xpp/PropertyReader.hxx>
+#include <xpp/SelectionReceiver.hxx>
+
+namespace xpp {
+
+void SelectionReceiver::request(const AtomID selection, const AtomID target, const AtomID property,
+		Sink sink, const XTime t) {
+	// needed to follow incremental transfers, keep whatever else the
+	// application selected on the window
+	if (!m_prev_events) {
+		m_prev_events = m_win.mergeEventSelection(EventSelectionMask{EventMask::PROPERTY_CHANGE});
+	}
+
+	m_sink = std::move(sink);
+	m_property = property;
+	m_type = AtomID::INVALID;
+	m_received = 0;
+	m_state = State::WAITING;
+
+	m_win.convertSelection(selection, target, property, t);
+}
+
+SelectionReceiver::~SelectionReceiver() {
+	restoreEvents();
+}
+
+bool SelectionReceiver::processEvent(const Event &event) {
+	switch (event.type()) {
+		case EventType::SELECTION_NOTIFY: {
+			const SelectionEvent notify{event};
+			if (m_state != State::WAITING || notify.requestor() != m_win.id())
+				return false;
+
+			if (notify.property() == AtomID::INVALID) {
+				m_state = State::REFUSED;
+				restoreEvents();
+				return true;
+			}
+
+			m_property = notify.property();
+			consume();
+
+			// deleting the INCR property in consume() started the
+			// incremental transfer
+			m_state = m_type == atoms::icccm_incr.atom(m_win.getDisplay()) ? State::INCR : State::DONE;
+			if (m_state == State::DONE) {
+				restoreEvents();
+			}
+			return true;
+		}
+		case EventType::PROPERTY_NOTIFY: {
+			const PropertyEvent prop{event};
+			if (m_state != State::INCR ||
+					prop.state() != PropertyNotification::NEW_VALUE ||
+					prop.window() != m_win.id() ||
+					prop.property() != m_property) {
+				return false;
+			}
+
+			// a zero-length chunk marks the end of the transfer
+			if (consume() == 0) {
+				m_state = State::DONE;
+				restoreEvents();
+			}
+
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+void SelectionReceiver::restoreEvents() {
+	if (m_prev_events) {
+		m_win.restoreEventSelection(*m_prev_events);
+		m_prev_events.reset();
+	}
+}
+
+size_t SelectionReceiver::consume() {
+	PropertyReader reader{m_win, m_property, m_chunk_size};
+	RawProperty chunk;
+	size_t bytes = 0;
+
+	while (reader.next(chunk)) {
+		m_type = reader.type();
+
+		// the INCR property only carries a size hint, no data
+		if (m_type == atoms::icccm_incr.atom(m_win.getDisplay()))
+			break;
+
+		if (chunk.length != 0) {
+			m_sink(chunk.view());
+			bytes += chunk.length;
+		}
+	}
+
+	m_received += bytes;
+	m_win.delProperty(m_property);
+	return bytes;
+}
+
+} // end ns
@@ -0,0 +1,222 @@
+// C++
+#include <algorithm>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/Event.hxx>
+#include <xpp/event/DestroyEvent.hxx>
+#include <xpp/event/PropertyEvent.hxx>
+#include <xpp/event/SelectionEvent.hxx>
+#include <xpp/event/SelectionRequestEvent.hxx>
+#include <xpp/helpers.hxx>
+#include <xpp/SelectionSender.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+
+namespace xpp {
+
+SelectionSender::SelectionSender(const size_t chunk_size, XDisplay &disp) :
+		m_display{&disp},
+		m_chunk_size{chunk_size} {
+	if (m_chunk_size == 0) {
+		// leave some room for the request header, but don't use
+		// excessively large chunks either
+		m_chunk_size = std::min<size_t>(m_display->maxRequestSize() - 64, 1024 * 1024);
+	}
+}
+
+void SelectionSender::serve(const SelectionRequestEvent &request, const AtomID type,
+		Source source, const std::optional<size_t> size_hint) {
+	// obsolete clients don't specify a property, ICCCM says to use the
+	// target atom then
+	const auto property = request.property() != AtomID::INVALID ?
+		request.property() : request.target();
+	const auto requestor = request.requestor();
+
+	Transfer transfer{type, std::move(source), {}, false, std::nullopt};
+	readChunk(transfer);
+
+	if (!transfer.eof) {
+		// avoid an INCR transfer for data of exactly one chunk
+		probeEOF(transfer);
+	}
+
+	if (transfer.eof) {
+		// everything fits into a single request
+		changeProperty(requestor, property, type, 8, transfer.chunk.data(), transfer.chunk.size());
+		notify(request, property);
+		return;
+	}
+
+	// we need to see the requestor deleting the property for continuing
+	// the transfer, and the requestor vanishing for aborting it. Keep
+	// whatever else the application selected on the window, the
+	// original selection is restored once the last transfer to the
+	// requestor ends.
+	if (m_requestors.find(requestor) == m_requestors.end()) {
+		XWindow req_win{requestor, *m_display};
+		m_requestors[requestor] = req_win.mergeEventSelection(EventSelectionMask{
+				EventMask::PROPERTY_CHANGE, EventMask::STRUCTURE_NOTIFY});
+	}
+
+	// the INCR property contains a lower bound of the data size
+	const long size = static_cast<long>(size_hint ? *size_hint : transfer.chunk.size());
+	changeProperty(requestor, property, atoms::icccm_incr.atom(*m_display), 32, &size, 1);
+	notify(request, property);
+
+	m_transfers[Key{requestor, property}] = std::move(transfer);
+}
+
+SelectionSender::~SelectionSender() {
+	// abort any transfers still in progress
+	for (const auto &[requestor, events]: m_requestors) {
+		XWindow{requestor, *m_display}.restoreEventSelection(events);
+	}
+}
+
+void SelectionSender::refuse(const SelectionRequestEvent &request) {
+	notify(request, AtomID::INVALID);
+}
+
+bool SelectionSender::processEvent(const Event &event) {
+	switch (event.type()) {
+		case EventType::PROPERTY_NOTIFY: {
+			const PropertyEvent prop{event};
+			if (prop.state() != PropertyNotification::PROPERTY_DELETE)
+				return false;
+			const auto win = prop.window();
+			if (!win)
+				return false;
+			const Key key{*win, prop.property()};
+			auto it = m_transfers.find(key);
+			if (it == m_transfers.end())
+				return false;
+
+			// the requestor consumed the previous chunk
+			writeChunk(key, it->second);
+			return true;
+		}
+		case EventType::DESTROY_NOTIFY: {
+			const auto win = DestroyEvent{event}.window();
+			bool found = false;
+
+			for (auto it = m_transfers.begin(); it != m_transfers.end(); ) {
+				if (it->first.first == win) {
+					it = m_transfers.erase(it);
+					found = true;
+				} else {
+					it++;
+				}
+			}
+
+			// the window is gone, nothing to restore
+			m_requestors.erase(win);
+			return found;
+		}
+		default:
+			return false;
+	}
+}
+
+void SelectionSender::readChunk(Transfer &transfer) {
+	transfer.chunk.resize(m_chunk_size);
+	size_t filled = 0;
+
+	if (transfer.lookahead) {
+		transfer.chunk[filled++] = *transfer.lookahead;
+		transfer.lookahead.reset();
+	}
+
+	while (filled < m_chunk_size) {
+		const auto got = transfer.source(transfer.chunk.data() + filled, m_chunk_size - filled);
+
+		if (got == 0) {
+			transfer.eof = true;
+			break;
+		}
+
+		filled += got;
+	}
+
+	transfer.chunk.resize(filled);
+}
+
+void SelectionSender::probeEOF(Transfer &transfer) {
+	char next;
+
+	if (transfer.source(&next, 1) == 0) {
+		transfer.eof = true;
+	} else {
+		transfer.lookahead = next;
+	}
+}
+
+void SelectionSender::writeChunk(const Key &key, Transfer &transfer) {
+	const auto [win, property] = key;
+
+	changeProperty(win, property, transfer.type, 8, transfer.chunk.data(), transfer.chunk.size());
+
+	if (transfer.chunk.empty()) {
+		// this was the final zero-length chunk
+		m_transfers.erase(key);
+		finishRequestor(win);
+		return;
+	}
+
+	if (transfer.eof) {
+		transfer.chunk.clear();
+	} else {
+		readChunk(transfer);
+	}
+}
+
+void SelectionSender::finishRequestor(const WinID requestor) {
+	// other transfers to the same window still need the events
+	auto pending = m_transfers.lower_bound(Key{requestor, AtomID::INVALID});
+	if (pending != m_transfers.end() && pending->first.first == requestor)
+		return;
+
+	auto it = m_requestors.find(requestor);
+	if (it == m_requestors.end())
+		return;
+
+	XWindow{requestor, *m_display}.restoreEventSelection(it->second);
+	m_requestors.erase(it);
+}
+
+void SelectionSender::notify(const SelectionRequestEvent &request, const AtomID property) {
+	XEvent raw{};
+	raw.type = SelectionNotify;
+	Event event{raw};
+	SelectionEventBuilder builder{event};
+
+	builder.setRequestor(request.requestor());
+	builder.setSelection(request.selection());
+	builder.setTarget(request.target());
+	builder.setProperty(property);
+	builder.setTime(request.time());
+
+	XWindow{request.requestor(), *m_display}.sendEvent(event);
+}
+
+void SelectionSender::changeProperty(const WinID win, const AtomID property, const AtomID type,
+		const int format, const void *data, const size_t items) {
+	const int res = ::XChangeProperty(
+		*m_display,
+		raw_win(win),
+		raw_atom(property),
+		raw_atom(type),
+		format,
+		PropModeReplace,
+		static_cast<const unsigned char*>(data),
+		static_cast<int>(items)
+	);
+
+	if (res == 0) {
+		throw XWindow::PropertyChangeError{*m_display, res};
+	}
+
+	m_display->autoFlush();
+}
+
+} // end ns
@@ -0,0 +1,253 @@
+// C++
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__)
+#	define XPP_ICONS_X86_64
+#	include <immintrin.h>
+#endif
+
+// cosmos
+#include <cosmos/error/UsageError.hxx>
+
+// xpp
+#include <xpp/WindowIcons.hxx>
+
+namespace xpp {
+
+namespace {
+
+	void narrow_scalar(const long *data, const size_t count, uint32_t *out) {
+		if constexpr (sizeof(long) == sizeof(uint32_t)) {
+			std::memcpy(out, data, count * sizeof(uint32_t));
+		} else {
+			for (size_t i = 0; i < count; i++) {
+				out[i] = static_cast<uint32_t>(data[i]);
+			}
+		}
+	}
+
+#ifdef XPP_ICONS_X86_64
+	/*
+	 * The lower half of each 64-bit item is picked via a float shuffle,
+	 * which combines two registers in a single instruction.
+	 */
+
+	__attribute__((target("sse2")))
+	void narrow_sse2(const long *data, const size_t count, uint32_t *out) {
+		size_t pos = 0;
+
+		for (; pos + 4 <= count; pos += 4) {
+			const __m128 first = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos)));
+			const __m128 second = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + 2)));
+			const __m128 packed = _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + pos), _mm_castps_si128(packed));
+		}
+
+		narrow_scalar(data + pos, count - pos, out + pos);
+	}
+
+	__attribute__((target("avx2")))
+	void narrow_avx2(const long *data, const size_t count, uint32_t *out) {
+		size_t pos = 0;
+
+		for (; pos + 8 <= count; pos += 8) {
+			const __m256 first = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos)));
+			const __m256 second = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos + 4)));
+			// the shuffle works per 128-bit lane, the 64-bit
+			// permutation restores the item order afterwards
+			const __m256 lanes = _mm256_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0));
+			const __m256i packed = _mm256_permute4x64_epi64(_mm256_castps_si256(lanes), _MM_SHUFFLE(3, 1, 2, 0));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + pos), packed);
+		}
+
+		narrow_sse2(data + pos, count - pos, out + pos);
+	}
+#endif
+
+	using NarrowFunc = void (*)(const long*, const size_t, uint32_t*);
+
+	NarrowFunc select_narrow() {
+#ifdef XPP_ICONS_X86_64
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+			return &narrow_avx2;
+		// SSE2 is part of the x86_64 baseline
+		return &narrow_sse2;
+#else
+		return &narrow_scalar;
+#endif
+	}
+
+	const NarrowFunc g_narrow = select_narrow();
+
+	/// Returns the extent fitting into `max` with the aspect ratio of `src`.
+	Extent fit_into(const Extent src, const Extent max) {
+		if (src.width <= max.width && src.height <= max.height)
+			return src;
+
+		// compare the aspect ratios without losing precision
+		const auto src_ratio = uint64_t{src.width} * max.height;
+		const auto max_ratio = uint64_t{max.width} * src.height;
+
+		if (src_ratio > max_ratio) {
+			const auto height = uint64_t{src.height} * max.width / src.width;
+			return Extent{max.width, std::max(static_cast<unsigned>(height), 1u)};
+		} else {
+			const auto width = uint64_t{src.width} * max.height / src.height;
+			return Extent{std::max(static_cast<unsigned>(width), 1u), max.height};
+		}
+	}
+
+} // end anon ns
+
+void narrow_format32(const long *data, const size_t count, uint32_t *out) {
+	g_narrow(data, count, out);
+}
+
+void WindowIcons::parse(const long *data, const size_t count, const std::optional<Extent> size) {
+	clear();
+
+	// first collect the icon headers, offsets refer to `data` for now
+	size_t pos = 0;
+	size_t total_pixels = 0;
+
+	while (count - pos >= 2) {
+		const Extent extent{
+			static_cast<uint32_t>(data[pos]),
+			static_cast<uint32_t>(data[pos + 1])
+		};
+		pos += 2;
+
+		const auto pixels = numPixels(extent);
+
+		if (pixels > count - pos) {
+			// truncated or bogus dimensions
+			break;
+		} else if (pixels != 0) {
+			m_entries.push_back(Entry{extent, pos});
+			total_pixels += pixels;
+		}
+
+		pos += pixels;
+	}
+
+	if (m_entries.empty()) {
+		return;
+	} else if (!size) {
+		m_pixels.resize(total_pixels);
+		size_t offset = 0;
+
+		for (auto &entry: m_entries) {
+			const auto pixels = numPixels(entry.extent);
+			narrow_format32(data + entry.offset, pixels, m_pixels.data() + offset);
+			entry.offset = offset;
+			offset += pixels;
+		}
+
+		return;
+	}
+
+	const auto selected = m_entries[selectBest(m_entries, *size)];
+	const auto target = fit_into(selected.extent, *size);
+	const auto src_pixels = numPixels(selected.extent);
+	m_entries.assign(1, Entry{target, 0});
+	m_pixels.resize(numPixels(target));
+
+	if (target.width == selected.extent.width && target.height == selected.extent.height) {
+		narrow_format32(data + selected.offset, src_pixels, m_pixels.data());
+		return;
+	}
+
+	// reused to avoid allocations for every window
+	thread_local std::vector<uint32_t> narrowed;
+	narrowed.resize(src_pixels);
+	narrow_format32(data + selected.offset, src_pixels, narrowed.data());
+	downscale(narrowed.data(), selected.extent, m_pixels.data(), target);
+}
+
+WindowIcons::Icon WindowIcons::at(const size_t index) const {
+	if (index >= m_entries.size()) {
+		cosmos_throw (cosmos::UsageError("WindowIcons index out of range"));
+	}
+
+	return (*this)[index];
+}
+
+std::optional<WindowIcons::Icon> WindowIcons::best(const Extent size) const {
+	if (m_entries.empty())
+		return std::nullopt;
+
+	return (*this)[selectBest(m_entries, size)];
+}
+
+size_t WindowIcons::selectBest(const std::vector<Entry> &entries, const Extent size) {
+	std::optional<size_t> covering;
+	size_t largest = 0;
+
+	for (size_t index = 0; index < entries.size(); index++) {
+		const auto extent = entries[index].extent;
+
+		if (numPixels(extent) > numPixels(entries[largest].extent)) {
+			largest = index;
+		}
+
+		if (extent.width < size.width || extent.height < size.height)
+			continue;
+
+		if (!covering || numPixels(extent) < numPixels(entries[*covering].extent)) {
+			covering = index;
+		}
+	}
+
+	return covering ? *covering : largest;
+}
+
+void WindowIcons::downscale(const uint32_t *src, const Extent src_extent,
+		uint32_t *dst, const Extent dst_extent) {
+	/*
+	 * This is a box filter: each target pixel is the average of the
+	 * source pixels it covers. The pixels are not premultiplied, thus
+	 * the colour channels are weighted by their alpha value, otherwise
+	 * transparent pixels would bleed their (meaningless) colour into the
+	 * result.
+	 */
+	for (unsigned y = 0; y < dst_extent.height; y++) {
+		const auto y0 = uint64_t{y} * src_extent.height / dst_extent.height;
+		const auto y1 = std::max(uint64_t{y + 1} * src_extent.height / dst_extent.height, y0 + 1);
+
+		for (unsigned x = 0; x < dst_extent.width; x++) {
+			const auto x0 = uint64_t{x} * src_extent.width / dst_extent.width;
+			const auto x1 = std::max(uint64_t{x + 1} * src_extent.width / dst_extent.width, x0 + 1);
+
+			uint64_t alpha = 0, red = 0, green = 0, blue = 0;
+
+			for (auto sy = y0; sy < y1; sy++) {
+				const auto row = src + sy * src_extent.width;
+
+				for (auto sx = x0; sx < x1; sx++) {
+					const auto pixel = row[sx];
+					const uint64_t a = pixel >> 24;
+					alpha += a;
+					red += a * ((pixel >> 16) & 0xff);
+					green += a * ((pixel >> 8) & 0xff);
+					blue += a * (pixel & 0xff);
+				}
+			}
+
+			const auto area = (y1 - y0) * (x1 - x0);
+			uint32_t result = 0;
+
+			if (alpha != 0) {
+				result = static_cast<uint32_t>(alpha / area) << 24 |
+					static_cast<uint32_t>(red / alpha) << 16 |
+					static_cast<uint32_t>(green / alpha) << 8 |
+					static_cast<uint32_t>(blue / alpha);
+			}
+
+			dst[size_t{y} * dst_extent.width + x] = result;
+		}
+	}
+}
+
+} // end ns
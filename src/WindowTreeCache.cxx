@@ -0,0 +1,250 @@
+// C++
+#include <vector>
+
+// xpp
+#include <xpp/Event.hxx>
+#include <xpp/event/CreateEvent.hxx>
+#include <xpp/event/DestroyEvent.hxx>
+#include <xpp/event/MapEvent.hxx>
+#include <xpp/event/ReparentEvent.hxx>
+#include <xpp/formatting.hxx>
+#include <xpp/private/instrument.hxx>
+#include <xpp/private/xcb.hxx>
+#include <xpp/private/Xpp.hxx>
+#include <xpp/WindowTreeCache.hxx>
+
+namespace xpp {
+
+void WindowTreeCache::seed(const SelectEvents select) {
+	m_select_events = select;
+	m_events_since_verify = 0;
+
+	if (m_select_events) {
+		// select before querying to not miss any changes in between
+		m_root.mergeEventSelection(EventSelectionMask{EventMask::SUBSTRUCTURE_NOTIFY});
+	}
+
+	EventMaskMap masks;
+	query(m_nodes, m_select_events ? &masks : nullptr);
+
+	if (m_select_events) {
+		for (const auto &pair: m_nodes) {
+			if (pair.first != m_root.id()) {
+				selectEvents(pair.first, masks[pair.first]);
+			}
+		}
+	}
+}
+
+void WindowTreeCache::query(NodeMap &nodes, EventMaskMap *event_masks) {
+	auto conn = xcb_connection(m_root.getDisplay());
+
+	nodes.clear();
+	m_root.queryTree();
+
+	const auto &tree = m_root.windowTree();
+	const auto &parents = m_root.windowParents();
+	std::vector<xcb_get_window_attributes_cookie_t> cookies;
+	cookies.reserve(tree.size());
+
+	for (const auto win: tree) {
+		cookies.push_back(::xcb_get_window_attributes(conn, raw_win(win)));
+	}
+
+	for (size_t num = 0; num < tree.size(); num++) {
+		const auto win = tree[num];
+		xcb_generic_error_t *error = nullptr;
+		XPP_COUNT_ROUND_TRIP(m_root.getDisplay());
+		XcbPtr<xcb_get_window_attributes_reply_t> reply{
+			::xcb_get_window_attributes_reply(conn, cookies[num], &error)};
+		XcbPtr<xcb_generic_error_t> error_guard{error};
+
+		auto &node = nodes[win];
+		node.mapped = reply && reply->map_state != XCB_MAP_STATE_UNMAPPED;
+
+		if (event_masks && reply) {
+			(*event_masks)[win] = reply->your_event_mask;
+		}
+
+		if (auto it = parents.find(win); it != parents.end()) {
+			node.parent = it->second;
+			// the parent always appears before its children
+			nodes[node.parent].children.insert(win);
+		}
+	}
+}
+
+uint32_t WindowTreeCache::ownEventMask(const WinID win) {
+	auto conn = xcb_connection(m_root.getDisplay());
+	const auto setup = ::xcb_get_setup(conn);
+	const auto raw = raw_win(win);
+
+	// only windows created by ourselves can carry an event selection of
+	// ours right after their creation, avoid a round trip for all others
+	if ((raw & ~setup->resource_id_mask) != setup->resource_id_base)
+		return 0;
+
+	xcb_generic_error_t *error = nullptr;
+	XPP_COUNT_ROUND_TRIP(m_root.getDisplay());
+	XcbPtr<xcb_get_window_attributes_reply_t> reply{::xcb_get_window_attributes_reply(
+			conn, ::xcb_get_window_attributes(conn, raw), &error)};
+	XcbPtr<xcb_generic_error_t> error_guard{error};
+
+	return reply ? reply->your_event_mask : 0;
+}
+
+void WindowTreeCache::selectEvents(const WinID win, const uint32_t current) {
+	auto conn = xcb_connection(m_root.getDisplay());
+	// keep any events the application selected on the window itself
+	const uint32_t mask = current | cosmos::to_integral(EventMask::SUBSTRUCTURE_NOTIFY);
+
+	if (mask == current)
+		return;
+
+	// the window might already be gone again, use a checked request and
+	// discard any error, to prevent it from reaching the Xlib error
+	// handler.
+	auto cookie = ::xcb_change_window_attributes_checked(
+			conn, raw_win(win), XCB_CW_EVENT_MASK, &mask);
+	::xcb_discard_reply(conn, cookie.sequence);
+}
+
+bool WindowTreeCache::addWindow(const WinID win, const WinID parent, const bool mapped) {
+	// a parent we don't know about means the window isn't part of the
+	// tree we're tracking (anymore), e.g. if the parent's DestroyNotify
+	// has already been processed.
+	if (m_nodes.find(parent) == m_nodes.end())
+		return false;
+
+	m_nodes[win].mapped = mapped;
+	setParent(win, parent);
+	return true;
+}
+
+void WindowTreeCache::setParent(const WinID win, const WinID parent) {
+	auto it = m_nodes.find(win);
+	if (it == m_nodes.end())
+		return;
+
+	auto parent_it = m_nodes.find(parent);
+	if (parent_it == m_nodes.end()) {
+		// the window moved out of the tracked tree
+		removeWindow(win);
+		return;
+	}
+
+	auto &node = it->second;
+
+	if (auto old_parent = m_nodes.find(node.parent); old_parent != m_nodes.end()) {
+		old_parent->second.children.erase(win);
+	}
+
+	node.parent = parent;
+	parent_it->second.children.insert(win);
+}
+
+void WindowTreeCache::setMapped(const WinID win, const bool mapped) {
+	// don't create phantom nodes for windows we don't know about, e.g.
+	// if the CreateNotify was missed
+	if (auto it = m_nodes.find(win); it != m_nodes.end()) {
+		it->second.mapped = mapped;
+	}
+}
+
+void WindowTreeCache::removeWindow(const WinID win) {
+	auto it = m_nodes.find(win);
+
+	if (it == m_nodes.end())
+		return;
+
+	if (auto parent = m_nodes.find(it->second.parent); parent != m_nodes.end()) {
+		parent->second.children.erase(win);
+	}
+
+	// X reports the destruction of sub-windows before their parent, but
+	// don't rely on all of these events being delivered to us.
+	std::vector<WinID> to_remove{win};
+
+	while (!to_remove.empty()) {
+		const auto current = to_remove.back();
+		to_remove.pop_back();
+
+		if (auto node = m_nodes.find(current); node != m_nodes.end()) {
+			to_remove.insert(to_remove.end(),
+				node->second.children.begin(), node->second.children.end());
+			m_nodes.erase(node);
+		}
+	}
+}
+
+bool WindowTreeCache::processEvent(const Event &event) {
+	switch (event.type()) {
+		case EventType::CREATE_NOTIFY: {
+			const CreateEvent create{event};
+			if (addWindow(create.window(), create.parent(), false) && m_select_events) {
+				selectEvents(create.window(), ownEventMask(create.window()));
+			}
+			break;
+		}
+		case EventType::DESTROY_NOTIFY: {
+			removeWindow(DestroyEvent{event}.window());
+			break;
+		}
+		case EventType::REPARENT_NOTIFY: {
+			const ReparentEvent reparent{event};
+			setParent(reparent.reparentedWindow(), reparent.newParent());
+			break;
+		}
+		case EventType::MAP_NOTIFY: {
+			setMapped(MapEvent{event}.window(), true);
+			break;
+		}
+		case EventType::UNMAP_NOTIFY: {
+			setMapped(UnmapEvent{event}.window(), false);
+			break;
+		}
+		default:
+			return false;
+	}
+
+	if (m_verify_interval != 0 && ++m_events_since_verify >= m_verify_interval) {
+		m_events_since_verify = 0;
+		verify();
+	}
+
+	return true;
+}
+
+size_t WindowTreeCache::verify() {
+	NodeMap actual;
+	query(actual, nullptr);
+	auto &logger = Xpp::getLogger();
+	size_t mismatches = 0;
+
+	for (const auto &[win, node]: actual) {
+		auto it = m_nodes.find(win);
+
+		if (it == m_nodes.end()) {
+			logger.warn() << "WindowTreeCache: window " << win << " is missing\n";
+			mismatches++;
+		} else if (it->second.parent != node.parent) {
+			logger.warn() << "WindowTreeCache: window " << win << " has parent "
+				<< it->second.parent << " but should be " << node.parent << "\n";
+			mismatches++;
+		} else if (it->second.mapped != node.mapped) {
+			logger.warn() << "WindowTreeCache: window " << win << " has wrong mapped state\n";
+			mismatches++;
+		}
+	}
+
+	for (const auto &pair: m_nodes) {
+		if (actual.find(pair.first) == actual.end()) {
+			logger.warn() << "WindowTreeCache: window " << pair.first << " no longer exists\n";
+			mismatches++;
+		}
+	}
+
+	return mismatches;
+}
+
+} // end ns
@@ -3,12 +3,15 @@
 #include <cosmos/error/UsageError.hxx>
 
 // xpp
+#include <xpp/CachedAtom.hxx>
 #include <xpp/Event.hxx>
-#include <xpp/RootWin.hxx>
+#include <xpp/EventRecorder.hxx>
 #include <xpp/SetWindowAttributes.hxx>
 #include <xpp/XColor.hxx>
 #include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
 #include <xpp/event/AnyEvent.hxx>
+#include <xpp/private/instrument.hxx>
 
 namespace xpp {
 
@@ -18,27 +21,180 @@ Visual *visual = nullptr;
 ColormapID colormap = ColormapID::INVALID;
 ScreenID screen = ScreenID::INVALID;
 
+namespace {
+
+	/// Drops atom IDs cached for the default display's previous connection.
+	/**
+	 * This must not race with other threads using the default display's
+	 * atoms, which is the case while the connection is being replaced
+	 * anyway.
+	 **/
+	void forget_default_atoms() {
+		xpp::atom_mapper.clear();
+		forget_cached_atoms();
+	}
+
+} // end anon ns
+
 XDisplay::~XDisplay() {
+	close();
+}
+
+void XDisplay::close() {
 	if (m_dis) {
+		XPP_INSTR_FORGET(m_dis);
+		m_instr_counters = nullptr;
 		::XCloseDisplay(m_dis);
 		m_dis = nullptr;
 	}
+
+	// cached atoms are only valid for the connection's server
+	delete m_atom_mapper.exchange(nullptr);
+}
+
+XDisplay& XDisplay::operator=(XDisplay &&other) noexcept {
+	if (this == &other)
+		return *this;
+
+	close();
+
+	m_dis = other.m_dis;
+	m_recorder = other.m_recorder;
+	m_batch_depth = other.m_batch_depth.load();
+	m_instr_counters = other.m_instr_counters.exchange(nullptr);
+	auto mapper = other.m_atom_mapper.exchange(nullptr);
+
+	if (this == &xpp::display) {
+		// the global caches might stem from a different server
+		delete mapper;
+		forget_default_atoms();
+	} else if (mapper) {
+		mapper->m_display = this;
+		m_atom_mapper = mapper;
+	}
+
+	other.m_dis = nullptr;
+	other.m_recorder = nullptr;
+	other.m_batch_depth = 0;
+	return *this;
 }
 
 XDisplay::XDisplay(const Initialize init) {
 	if (init) {
 		// if nullptr is specified, then the value of DISPLAY environment will be used
-		m_dis = ::XOpenDisplay(nullptr);
+		open(nullptr);
+	}
+}
+
+XDisplay::XDisplay(const cosmos::SysString name) {
+	open(name.raw());
+}
+
+void XDisplay::open(const char *name) {
+	m_dis = ::XOpenDisplay(name);
+
+	if (!m_dis) {
+		throw DisplayOpenError{name};
+	}
 
-		if (!m_dis) {
-			throw DisplayOpenError{};
-		}
+	if (this == &xpp::display) {
+		forget_default_atoms();
+	}
+}
+
+AtomMapper& XDisplay::atomMapper() {
+	if (this == &xpp::display)
+		return xpp::atom_mapper;
+
+	if (auto mapper = m_atom_mapper.load(std::memory_order_acquire); mapper)
+		return *mapper;
+
+	// another thread might allocate one at the same time, only one wins
+	auto mapper = new AtomMapper{*this};
+	AtomMapper *expected = nullptr;
+
+	if (!m_atom_mapper.compare_exchange_strong(expected, mapper, std::memory_order_acq_rel)) {
+		delete mapper;
+		return *expected;
+	}
+
+	return *mapper;
+}
+
+AtomID XDisplay::mapAtom(const cosmos::SysString name) {
+	XPP_MEASURE(m_dis, "XDisplay::mapAtom");
+	XPP_COUNT_ROUND_TRIP(*this);
+	auto ret = ::XInternAtom(m_dis, name.raw(), False);
+
+	if (ret == BadAlloc || ret == BadValue || ret == None) {
+		cosmos_throw (AtomMappingError(m_dis, ret, name));
+	}
+
+	return AtomID{ret};
+}
+
+void XDisplay::mapAtoms(const std::vector<cosmos::SysString> &names, AtomIDVector &atoms) {
+	std::vector<char*> raw_names;
+	raw_names.reserve(names.size());
+	// the names are declared non-const but are never modified in Xlib
+	for (const auto &name: names) {
+		raw_names.push_back(const_cast<char*>(name.raw()));
+	}
+
+	AtomVector raw_atoms(names.size(), None);
+
+	XPP_MEASURE(m_dis, "XDisplay::mapAtoms");
+	XPP_COUNT_ROUND_TRIP(*this);
+
+	const auto res = ::XInternAtoms(m_dis,
+			raw_names.data(), static_cast<int>(raw_names.size()),
+			False, raw_atoms.data());
+
+	if (res == 0) {
+		cosmos_throw (AtomMappingError(m_dis, BadAtom, "<bulk atom request>"));
+	}
+
+	atoms.clear();
+	atoms.reserve(raw_atoms.size());
+
+	for (const auto atom: raw_atoms) {
+		atoms.push_back(AtomID{atom});
+	}
+}
+
+std::string XDisplay::mapName(const AtomID atom) {
+	XPP_MEASURE(m_dis, "XDisplay::mapName");
+	XPP_COUNT_ROUND_TRIP(*this);
+	auto str = ::XGetAtomName(m_dis, raw_atom(atom));
+	std::string ret{str};
+	::XFree(str);
+	return ret;
+}
+
+void XDisplay::flush() {
+	XPP_MEASURE(m_dis, "XDisplay::flush");
+	XPP_COUNT_FLUSH(*this);
+	if (::XFlush(m_dis) == 0) {
+		cosmos_throw (X11Exception("XFlush failed"));
+	}
+}
+
+void XDisplay::sync() {
+	XPP_MEASURE(m_dis, "XDisplay::sync");
+	XPP_COUNT_FLUSH(*this);
+	XPP_COUNT_ROUND_TRIP(*this);
+	if (::XSync(m_dis, False) == 0) {
+		cosmos_throw (X11Exception("XSync failed"));
 	}
 }
 
 void XDisplay::nextEvent(Event &event) {
 	// xlib unconditionally returns 0 here (not documented)
 	(void)::XNextEvent(m_dis, event.raw());
+
+	if (m_recorder) {
+		m_recorder->record(event);
+	}
 }
 
 bool XDisplay::sameDisplay(const AnyEvent &event) {
@@ -59,11 +215,9 @@ WinID XDisplay::createWindow(
 		throw cosmos::UsageError{"attrs cannot be unset if value_mask is set"};
 	}
 
-	static RootWin root_win;
-
 	auto res = ::XCreateWindow(
 		m_dis,
-		raw_win(parent.value_or(&root_win)->id()),
+		raw_win(parent ? (*parent)->id() : rootWindow()),
 		spec.x, spec.y, spec.width, spec.height,
 		border_width,
 		depth ? *depth : defaultDepth(),
@@ -97,16 +251,16 @@ XDisplay::AtomMappingError::AtomMappingError(Display *dis, const int errcode,
 	m_msg = std::string("Trying to map atom '") + std::string{s} + std::string("':") + m_msg;
 }
 
-XDisplay::DisplayOpenError::DisplayOpenError() :
+XDisplay::DisplayOpenError::DisplayOpenError(const char *name) :
 		CosmosError{"DisplayOpenError"} {
 	m_msg = "Unable to open X11 display: \"";
-	m_msg += ::XDisplayName(nullptr);
+	m_msg += ::XDisplayName(name);
 	m_msg += "\". ";
 }
 
 void XDisplay::parseColor(XColor &out, const cosmos::SysString name, const std::optional<ColormapID> p_colormap) {
 	auto res = ::XParseColor(m_dis,
-			raw_cmap(p_colormap ? *p_colormap : xpp::colormap),
+			raw_cmap(p_colormap ? *p_colormap : defaultColormap()),
 			name.raw(),
 			&out);
 
@@ -116,6 +270,8 @@ void XDisplay::parseColor(XColor &out, const cosmos::SysString name, const std::
 }
 
 std::optional<WinID> XDisplay::selectionOwner(const AtomID selection) const {
+	XPP_MEASURE(m_dis, "XDisplay::selectionOwner");
+	XPP_COUNT_ROUND_TRIP(*this);
 	auto win = ::XGetSelectionOwner(m_dis, raw_atom(selection));
 
 	if (win == None)
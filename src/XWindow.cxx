@@ -1,9 +1,9 @@
 // C++
 #include <cassert>
 #include <sstream>
+#include <vector>
 
 // cosmos
-#include <cosmos/error/InternalError.hxx>
 #include <cosmos/formatting.hxx>
 #include <cosmos/memory.hxx>
 
@@ -12,9 +12,14 @@
 #include <xpp/formatting.hxx>
 #include <xpp/GraphicsContext.hxx>
 #include <xpp/helpers.hxx>
+#include <xpp/private/instrument.hxx>
+#include <xpp/private/xcb.hxx>
 #include <xpp/private/Xpp.hxx>
 #include <xpp/Property.hxx>
+#include <xpp/PropertyView.hxx>
 #include <xpp/SizeHints.hxx>
+#include <xpp/text.hxx>
+#include <xpp/WindowIcons.hxx>
 #include <xpp/WindowManagerHints.hxx>
 #include <xpp/XCursor.hxx>
 #include <xpp/XWindowAttrs.hxx>
@@ -22,12 +27,31 @@
 
 namespace xpp {
 
-XWindow::PropertyTypeMismatch::PropertyTypeMismatch(AtomID expected, AtomID encountered,
+namespace {
+
+	/// Retrieves a property of type PROPTYPE and converts its value to RESULT.
+	template <typename PROPTYPE, typename RESULT>
+	PropertyResult<RESULT> try_get_as(const XWindow &win, const CachedAtom &atom) {
+		Property<PROPTYPE> prop;
+
+		if (const auto status = win.tryGetProperty(atom, prop); status != PropertyStatus::OK) {
+			return status;
+		}
+
+		return RESULT{prop.get()};
+	}
+
+} // end anon ns
+
+XWindow::PropertyTypeMismatch::PropertyTypeMismatch(XDisplay &disp,
+			AtomID expected, AtomID encountered,
 			const cosmos::SourceLocation &loc) :
 		CosmosError{"PropertyTypeMismatch",
 			"Retrieved property has different type than expected", loc} {
+	auto &mapper = disp.atomMapper();
 	std::ostringstream s;
-	s << "Expected " << expected << " but encountered " << encountered;
+	s << "Expected " << raw_atom(expected) << " (" << mapper.mapName(expected) << ")"
+		<< " but encountered " << raw_atom(encountered) << " (" << mapper.mapName(encountered) << ")";
 	m_msg += s.str();
 }
 
@@ -43,8 +67,9 @@ XWindow::PropertyQueryError::PropertyQueryError(Display *dis, const int errcode,
 	m_msg = std::string("Error querying property: ") + m_msg;
 }
 
-XWindow::XWindow(WinID win) :
+XWindow::XWindow(WinID win, XDisplay &disp) :
 		XWindow{} {
+	m_display = &disp;
 	m_win = win;
 }
 
@@ -53,13 +78,11 @@ Window XWindow::rawID() const {
 }
 
 std::string XWindow::getName() const {
-	try {
-		xpp::Property<utf8_string> utf8_name;
-
-		this->getProperty(atoms::ewmh_window_name, utf8_name);
+	xpp::Property<utf8_string> utf8_name;
 
+	if (tryGetProperty(atoms::ewmh_window_name, utf8_name) == PropertyStatus::OK) {
 		return utf8_name.get().str.data();
-	} catch(...) {}
+	}
 
 	/*
 	 * If EWMH name property is not present then try to fall back to ICCCM
@@ -75,6 +98,17 @@ std::string XWindow::getName() const {
 	return name.get();
 }
 
+PropertyResult<std::string> XWindow::tryGetName() const {
+	xpp::Property<utf8_string> utf8_name;
+
+	if (tryGetProperty(atoms::ewmh_window_name, utf8_name) == PropertyStatus::OK) {
+		return std::string{utf8_name.get().str.data()};
+	}
+
+	// see getName()
+	return try_get_as<const char*, std::string>(*this, atoms::icccm_window_name);
+}
+
 void XWindow::setName(const std::string_view name) {
 	try {
 		xpp::Property<utf8_string> utf8_name;
@@ -99,6 +133,10 @@ cosmos::ProcessID XWindow::getPID() const {
 	return cosmos::ProcessID{pid.get()};
 }
 
+PropertyResult<cosmos::ProcessID> XWindow::tryGetPID() const {
+	return try_get_as<int, cosmos::ProcessID>(*this, atoms::ewmh_window_pid);
+}
+
 int XWindow::getDesktop() const {
 	xpp::Property<int> desktop_nr;
 
@@ -108,6 +146,10 @@ int XWindow::getDesktop() const {
 	return ret;
 }
 
+PropertyResult<int> XWindow::tryGetDesktop() const {
+	return try_get_as<int, int>(*this, atoms::ewmh_window_desktop);
+}
+
 std::string XWindow::getClientMachine() const {
 	xpp::Property<const char *> name;
 
@@ -116,6 +158,10 @@ std::string XWindow::getClientMachine() const {
 	return name.get();
 }
 
+PropertyResult<std::string> XWindow::tryGetClientMachine() const {
+	return try_get_as<const char*, std::string>(*this, atoms::icccm_wm_client_machine);
+}
+
 std::string XWindow::getCommand() const {
 	xpp::Property<const char *> name;
 
@@ -124,6 +170,10 @@ std::string XWindow::getCommand() const {
 	return name.get();
 }
 
+PropertyResult<std::string> XWindow::tryGetCommand() const {
+	return try_get_as<const char*, std::string>(*this, atoms::icccm_wm_command);
+}
+
 std::string XWindow::getLocale() const {
 	xpp::Property<const char *> locale;
 
@@ -132,6 +182,10 @@ std::string XWindow::getLocale() const {
 	return locale.get();
 }
 
+PropertyResult<std::string> XWindow::tryGetLocale() const {
+	return try_get_as<const char*, std::string>(*this, atoms::icccm_wm_locale);
+}
+
 WinID XWindow::getClientLeader() const {
 	xpp::Property<WinID> leader;
 
@@ -140,6 +194,10 @@ WinID XWindow::getClientLeader() const {
 	return leader.get();
 }
 
+PropertyResult<WinID> XWindow::tryGetClientLeader() const {
+	return try_get_as<WinID, WinID>(*this, atoms::icccm_wm_client_leader);
+}
+
 AtomID XWindow::getWindowType() const {
 	xpp::Property<AtomID> type;
 
@@ -148,6 +206,33 @@ AtomID XWindow::getWindowType() const {
 	return type.get();
 }
 
+PropertyResult<AtomID> XWindow::tryGetWindowType() const {
+	return try_get_as<AtomID, AtomID>(*this, atoms::ewmh_wm_window_type);
+}
+
+void XWindow::getIcons(WindowIcons &icons, const std::optional<Extent> size) const {
+	// parse directly from the Xlib buffer without an intermediate copy
+	Property<PropertyView<int>> raw;
+
+	this->getProperty(atoms::ewmh_wm_icon, raw);
+
+	const auto items = raw.get().raw();
+	icons.parse(items.data(), items.size(), size);
+}
+
+PropertyStatus XWindow::tryGetIcons(WindowIcons &icons, const std::optional<Extent> size) const {
+	Property<PropertyView<int>> raw;
+
+	if (const auto status = this->tryGetProperty(atoms::ewmh_wm_icon, raw); status != PropertyStatus::OK) {
+		icons.clear();
+		return status;
+	}
+
+	const auto items = raw.get().raw();
+	icons.parse(items.data(), items.size(), size);
+	return PropertyStatus::OK;
+}
+
 void XWindow::getProtocols(AtomIDVector &protocols) const {
 	protocols.clear();
 
@@ -155,14 +240,14 @@ void XWindow::getProtocols(AtomIDVector &protocols) const {
 	int ret_count = 0;
 
 	const auto status = ::XGetWMProtocols(
-		display,
+		*m_display,
 		rawID(),
 		&ret,
 		&ret_count
 	);
 
 	if (status == 0) {
-		throw X11Exception{display, status};
+		throw X11Exception{*m_display, status};
 	}
 
 	for (int num = 0; num < ret_count; num++) {
@@ -172,21 +257,24 @@ void XWindow::getProtocols(AtomIDVector &protocols) const {
 	::XFree(ret);
 }
 
-void XWindow::setProtocols(const AtomIDVector &protocols) {
+RequestToken XWindow::setProtocols(const AtomIDVector &protocols) {
 	AtomVector plain;
 	for (const auto &prot: protocols) {
 		plain.push_back(static_cast<Atom>(prot));
 	}
 
-	auto res = ::XSetWMProtocols(display, rawID(), plain.data(), plain.size());
+	const auto first = m_display->nextRequest();
+	auto res = ::XSetWMProtocols(*m_display, rawID(), plain.data(), plain.size());
 
 	if (res != True) {
-		throw X11Exception{display, res};
+		throw X11Exception{*m_display, res};
 	}
+
+	return RequestToken{*m_display, first};
 }
 
 std::shared_ptr<WindowManagerHints> XWindow::getWMHints() const {
-	auto hints = ::XGetWMHints(display, rawID());
+	auto hints = ::XGetWMHints(*m_display, rawID());
 
 	if (!hints) {
 		return nullptr;
@@ -195,59 +283,110 @@ std::shared_ptr<WindowManagerHints> XWindow::getWMHints() const {
 	return make_shared_xptr(reinterpret_cast<WindowManagerHints*>(hints));
 }
 
-void XWindow::setWMHints(const WindowManagerHints &hints) {
+RequestToken XWindow::setWMHints(const WindowManagerHints &hints) {
 	const XWMHints *base = &hints;
+	const auto first = m_display->nextRequest();
 	// currently always returns 1, hints aren't modified in the lib
-	(void)::XSetWMHints(display, rawID(), const_cast<XWMHints*>(base));
+	(void)::XSetWMHints(*m_display, rawID(), const_cast<XWMHints*>(base));
+	return RequestToken{*m_display, first};
 }
 
-void XWindow::setClassHints(const ClassHints hints) {
+RequestToken XWindow::setClassHints(const ClassHints hints) {
 	// no negative returns codes ever occur
 	// the hints parameter is declared non-const but the structure is
 	// never modified in the implementation.
 	const XClassHint *base = &hints;
-	(void)::XSetClassHint(display, rawID(), const_cast<XClassHint*>(base));
+	const auto first = m_display->nextRequest();
+	(void)::XSetClassHint(*m_display, rawID(), const_cast<XClassHint*>(base));
+	return RequestToken{*m_display, first};
 }
 
-void XWindow::setWMNormalHints(const SizeHints &hints) {
+RequestToken XWindow::setWMNormalHints(const SizeHints &hints) {
 	const XSizeHints *base = &hints;
+	const auto first = m_display->nextRequest();
 	// has no return code, doesn't modify the hints structure
-	::XSetWMNormalHints(display, rawID(), const_cast<XSizeHints*>(base));
+	::XSetWMNormalHints(*m_display, rawID(), const_cast<XSizeHints*>(base));
+	return RequestToken{*m_display, first};
 }
 
 XWindow::ClassStringPair XWindow::getClass() const {
+	ClassStringPair ret;
+	QueryDetails details;
+
+	if (const auto status = queryClass(ret, details); status != PropertyStatus::OK) {
+		throwQueryError(status, details);
+	}
+
+	return ret;
+}
+
+PropertyResult<XWindow::ClassStringPair> XWindow::tryGetClass() const {
+	ClassStringPair ret;
+	QueryDetails details;
+
+	if (const auto status = queryClass(ret, details); status != PropertyStatus::OK) {
+		return status;
+	}
+
+	return ret;
+}
+
+PropertyStatus XWindow::queryClass(ClassStringPair &out, QueryDetails &details) const {
 	/*
 	 * there's a special pair of functions X{Set,Get}ClassHint but that
 	 * would be more work for us, we get the raw property which consists
 	 * of two consecutive null terminated strings
 	 */
-	xpp::Property<const char *> clazz;
+	PropertyInfo info;
+	// a single request should suffice for any sane WM_CLASS
+	RawProperty raw{256};
+
+	while (true) {
+		if (const auto res = queryRawProperty(atoms::icccm_wm_class, info, raw); res != Success) {
+			details.x_error = res;
+			return PropertyStatus::QUERY_ERROR;
+		} else if (raw.left == 0) {
+			break;
+		}
 
-	this->getProperty(atoms::icccm_wm_class, clazz);
+		raw = RawProperty{(info.numBytes() + 3) & ~size_t{3}};
+	}
 
-	ClassStringPair ret;
+	details.expected_type = AtomID{XA_STRING};
+	details.actual_type = info.type;
 
-	ret.first = std::string{clazz.get()};
-	// this is not very safe but our Property modelling currently lacks
-	// support for strings containing null terminators (we can't get the
-	// complete size from the property)
-	ret.second = std::string{clazz.get() + ret.first.length() + 1};
+	if (info.type == AtomID::INVALID) {
+		return PropertyStatus::NOT_EXISTING;
+	} else if (info.type != details.expected_type || info.format != 8) {
+		return PropertyStatus::TYPE_MISMATCH;
+	}
 
-	return ret;
+	// the strings are Latin-1 encoded, thus the UTF-8 check is meaningless
+	thread_local std::vector<std::string_view> parts;
+	(void)text::split_list(raw.view(), parts);
+
+	out.first = parts.size() > 0 ? parts[0] : std::string_view{};
+	out.second = parts.size() > 1 ? parts[1] : std::string_view{};
+
+	return PropertyStatus::OK;
 }
 
-void XWindow::destroy() {
-	const auto res = ::XDestroyWindow(display, rawID());
-	display.flush();
+RequestToken XWindow::destroy() {
+	XPP_MEASURE(*m_display, "XWindow::destroy");
+	const auto first = m_display->nextRequest();
+	const auto res = ::XDestroyWindow(*m_display, rawID());
+	m_display->autoFlush();
 
 	if (res != 1) {
-		throw X11Exception{display, res};
+		throw X11Exception{*m_display, res};
 	}
+
+	return RequestToken{*m_display, first};
 }
 
 WinID XWindow::createChild() {
 	Window new_win = ::XCreateSimpleWindow(
-		display,
+		*m_display,
 		rawID(),
 		// dimensions and alike don't matter for this hidden window
 		-10, -10, 1, 1, 0, 0, 0
@@ -257,19 +396,21 @@ WinID XWindow::createChild() {
 		throw X11Exception{"Failed to create pseudo child window"};
 	}
 
-	display.flush();
+	m_display->autoFlush();
 
 	return WinID{new_win};
 }
 
-void XWindow::convertSelection(
+RequestToken XWindow::convertSelection(
 		const AtomID selection,
 		const AtomID target_type,
 		const AtomID target_prop,
 		const XTime t) {
 
+	const auto first = m_display->nextRequest();
+
 	if (::XConvertSelection(
-			display,
+			*m_display,
 			raw_atom(selection),
 			raw_atom(target_type),
 			raw_atom(target_prop),
@@ -278,21 +419,25 @@ void XWindow::convertSelection(
 		throw X11Exception{"Failed to request selection conversion"};
 	}
 
-	display.flush();
+	m_display->autoFlush();
+
+	return RequestToken{*m_display, first};
 }
 
-void XWindow::makeSelectionOwner(const AtomID selection, const XTime t) {
+RequestToken XWindow::makeSelectionOwner(const AtomID selection, const XTime t) {
+	const auto first = m_display->nextRequest();
 	// libX11 always returns 1 here, so ignore it
-	::XSetSelectionOwner(display, raw_atom(selection), rawID(), cosmos::to_integral(t));
+	::XSetSelectionOwner(*m_display, raw_atom(selection), rawID(), cosmos::to_integral(t));
+	return RequestToken{*m_display, first};
 }
 
 void XWindow::sendDeleteRequest() {
 	long data[2];
-	data[0] = raw_atom(atoms::icccm_wm_delete_window);
+	data[0] = raw_atom(atoms::icccm_wm_delete_window.atom(*m_display));
 	data[1] = CurrentTime;
 
 	sendRequest(
-		atoms::icccm_wm_protocols,
+		atoms::icccm_wm_protocols.atom(*m_display),
 		(const char*)&data[0],
 		sizeof(data),
 		this
@@ -308,7 +453,7 @@ void XWindow::sendRequest(
 
 	logger.debug()
 		<< "Sending request to window " << *this << ":"
-		<< "msg = " << message << " with " << len << " bytes of data, window = "
+		<< "msg = " << raw_atom(message) << " (" << m_display->atomMapper().mapName(message) << ") with " << len << " bytes of data, window = "
 		<< to_string(window ? window->id() : WinID{0}) << std::endl;
 
 	XEvent event;
@@ -329,14 +474,16 @@ void XWindow::sendRequest(
 	sendEvent(event);
 }
 
-void XWindow::sendEvent(const Event &event) {
+RequestToken XWindow::sendEvent(const Event &event) {
 	auto raw = event.raw();
-	sendEvent(*raw);
+	return sendEvent(*raw);
 }
 
-void XWindow::sendEvent(const XEvent &event) {
+RequestToken XWindow::sendEvent(const XEvent &event) {
+	XPP_MEASURE(*m_display, "XWindow::sendEvent");
+	const auto first = m_display->nextRequest();
 	const Status s = ::XSendEvent(
-		display,
+		*m_display,
 		rawID(),
 		False,
 		m_send_event_mask.raw(),
@@ -344,21 +491,67 @@ void XWindow::sendEvent(const XEvent &event) {
 	);
 
 	if (s == BadValue || s == BadWindow) {
-		throw X11Exception{display, s};
+		throw X11Exception{*m_display, s};
 	}
 
 	// make sure the event gets sent out
-	display.flush();
+	m_display->autoFlush();
+
+	return RequestToken{*m_display, first};
 }
 
 void XWindow::selectEvent(const EventMask new_event) const {
 	m_input_event_mask.set(new_event);
 
-	const int res = ::XSelectInput(display, rawID(), m_input_event_mask.raw());
+	const int res = ::XSelectInput(*m_display, rawID(), m_input_event_mask.raw());
+
+	if (res == 0) {
+		throw X11Exception{"XSelectInput failed"};
+	}
+}
+
+EventSelectionMask XWindow::mergeEventSelection(const EventSelectionMask events) const {
+	XWindowAttributes attrs;
+	XPP_MEASURE(*m_display, "XWindow::mergeEventSelection");
+	XPP_COUNT_ROUND_TRIP(*m_display);
+
+	if (::XGetWindowAttributes(*m_display, rawID(), &attrs) == 0) {
+		throw X11Exception{"XGetWindowAttributes failed"};
+	}
+
+	const EventSelectionMask previous{static_cast<EventSelectionMask::EnumBaseType>(attrs.your_event_mask)};
+	m_input_event_mask = previous;
+	m_input_event_mask.set(events);
+
+	const int res = ::XSelectInput(*m_display, rawID(), m_input_event_mask.raw());
 
 	if (res == 0) {
 		throw X11Exception{"XSelectInput failed"};
 	}
+
+	return previous;
+}
+
+void XWindow::restoreEventSelection(const EventSelectionMask previous) const {
+	auto conn = xcb_connection(*m_display);
+	const uint32_t mask = static_cast<uint32_t>(previous.raw());
+
+	m_input_event_mask = previous;
+
+	// use a checked request and discard any error, to prevent it from
+	// reaching the Xlib error handler.
+	auto cookie = ::xcb_change_window_attributes_checked(
+			conn, rawID(), XCB_CW_EVENT_MASK, &mask);
+	::xcb_discard_reply(conn, cookie.sequence);
+}
+
+void XWindow::throwQueryError(const PropertyStatus status, const QueryDetails &details) const {
+	switch (status) {
+		case PropertyStatus::NOT_EXISTING: throw PropertyNotExisting{};
+		case PropertyStatus::TYPE_MISMATCH:
+			throw PropertyTypeMismatch{*m_display, details.expected_type, details.actual_type};
+		default: throw PropertyQueryError{*m_display, details.x_error};
+	}
 }
 
 void XWindow::getPropertyList(AtomIDVector &atoms) {
@@ -366,7 +559,7 @@ void XWindow::getPropertyList(AtomIDVector &atoms) {
 
 	int num_atoms = 0;
 
-	Atom *list = ::XListProperties(display, rawID(), &num_atoms);
+	Atom *list = ::XListProperties(*m_display, rawID(), &num_atoms);
 
 	if (list == nullptr) {
 		// could be an error (probably) or a window without any
@@ -389,7 +582,26 @@ void XWindow::getPropertyInfo(const AtomID property, PropertyInfo &info) {
 	getRawProperty(property, info, p);
 }
 
+PropertyStatus XWindow::tryGetPropertyInfo(const AtomID property, PropertyInfo &info) {
+	RawProperty p;
+	return tryGetRawProperty(property, info, p);
+}
+
 void XWindow::getRawProperty(const AtomID property, PropertyInfo &info, RawProperty &out) {
+	if (const auto res = queryRawProperty(property, info, out); res != Success) {
+		throw X11Exception{*m_display, res};
+	}
+}
+
+PropertyStatus XWindow::tryGetRawProperty(const AtomID property, PropertyInfo &info, RawProperty &out) {
+	if (queryRawProperty(property, info, out) != Success) {
+		return PropertyStatus::QUERY_ERROR;
+	}
+
+	return info.type == AtomID::INVALID ? PropertyStatus::NOT_EXISTING : PropertyStatus::OK;
+}
+
+int XWindow::queryRawProperty(const AtomID property, PropertyInfo &info, RawProperty &out) const {
 	int actual_format = 0;
 	unsigned long number_items = 0;
 	/*
@@ -406,7 +618,7 @@ void XWindow::getRawProperty(const AtomID property, PropertyInfo &info, RawPrope
 	Atom type = None;
 
 	const auto res = ::XGetWindowProperty(
-		display,
+		*m_display,
 		rawID(),
 		raw_atom(property),
 		out.offset / 4, /* offset in 32-bit multiples */
@@ -421,7 +633,7 @@ void XWindow::getRawProperty(const AtomID property, PropertyInfo &info, RawPrope
 	);
 
 	if (res != Success) {
-		throw X11Exception{display, res};
+		return res;
 	}
 
 	info.type = AtomID{type};
@@ -438,15 +650,18 @@ void XWindow::getRawProperty(const AtomID property, PropertyInfo &info, RawPrope
 	out.left = bytes_left;
 	out.length = number_items * bytes_per_item;
 	out.data = make_shared_xptr(prop_data);
+	return Success;
 }
 
 template <typename PROPTYPE>
-void XWindow::getProperty(const AtomID name_atom, Property<PROPTYPE> &prop, const PropertyInfo *info) const {
+PropertyStatus XWindow::queryProperty(const AtomID name_atom, Property<PROPTYPE> &prop,
+		const PropertyInfo *info, QueryDetails &details) const {
 	// shorthand for our concrete property object
 	typedef Property<PROPTYPE> THIS_PROP;
 
-	auto x_type = THIS_PROP::getXType();
+	auto x_type = THIS_PROP::getXType(*m_display);
 	assert(x_type != AtomID::INVALID);
+	details.expected_type = x_type;
 
 	Atom actual_type;
 	// if 8, 16, or 32-bit format was actually read
@@ -455,79 +670,113 @@ void XWindow::getProperty(const AtomID name_atom, Property<PROPTYPE> &prop, cons
 	unsigned long remaining_bytes = 0;
 	unsigned char *data = nullptr;
 
-	const size_t max_len = info ?
-		(info->items * (info->format / 8)) : 65536 / 4;
+	// maximum length of the property to read in 32-bit units
+	size_t max_len = info ? (info->numBytes() + 3) / 4 : 65536 / 4;
 
-	const int res = ::XGetWindowProperty(
-		display,
-		rawID(),
-		raw_atom(name_atom),
-		// offset into the property data
-		0,
-		// maximum length of the property to read in 32-bit items
-		max_len,
-		// delete request
-		False,
-		// our expected type
-		raw_atom(x_type),
-		// actually present type, format, number of items
-		&actual_type,
-		&actual_format,
-		&ret_items,
-		&remaining_bytes,
-		// where data is stored
-		&data
-	);
+	XPP_MEASURE(*m_display, "XWindow::getProperty");
+
+	while (true) {
+		XPP_COUNT_ROUND_TRIP(*m_display);
+		const int res = ::XGetWindowProperty(
+			*m_display,
+			rawID(),
+			raw_atom(name_atom),
+			// offset into the property data
+			0,
+			max_len,
+			// delete request
+			False,
+			// our expected type
+			raw_atom(x_type),
+			// actually present type, format, number of items
+			&actual_type,
+			&actual_format,
+			&ret_items,
+			&remaining_bytes,
+			// where data is stored
+			&data
+		);
+
+		// note: on success data is allocated by Xlib. data always contains
+		// one excess byte that is set to zero thus its possible to use data
+		// as a c-string without copying it.
+		if  (res != Success) {
+			details.x_error = res;
+			return PropertyStatus::QUERY_ERROR;
+		}
 
-	// note: on success data is allocated by Xlib. data always contains
-	// one excess byte that is set to zero thus its possible to use data
-	// as a c-string without copying it.
-	if  (res != Success) {
-		throw PropertyQueryError{display, res};
+		if (remaining_bytes == 0 || AtomID{actual_type} != x_type)
+			break;
+
+		// the property is larger than expected, now we know its full
+		// size so request it completely
+		max_len = (ret_items * (actual_format / 8) + remaining_bytes + 3) / 4;
+		::XFree(data);
+		data = nullptr;
 	}
 
-	try {
-		AtomID this_type{actual_type};
-		if (this_type == AtomID::INVALID) {
-			throw PropertyNotExisting{};
-		} else if (x_type != this_type) {
-			throw PropertyTypeMismatch{x_type, this_type};
-		} else if (remaining_bytes != 0) {
-			throw cosmos::InternalError{"Bytes remaining during property read"};
+	AtomID this_type{actual_type};
+	details.actual_type = this_type;
+
+	if (this_type == AtomID::INVALID || this_type != x_type) {
+		if (data) {
+			::XFree(data);
 		}
 
-		assert (actual_format == THIS_PROP::Traits::FORMAT);
+		return this_type == AtomID::INVALID ?
+			PropertyStatus::NOT_EXISTING : PropertyStatus::TYPE_MISMATCH;
+	}
+
+	assert (actual_format == THIS_PROP::Traits::FORMAT);
 
+	try {
 		// ret_items gives the number of items acc. to actual_format that have been returned
+		XPP_COUNT_BYTES_RECEIVED(*m_display, ret_items * (actual_format / 8));
 		prop.takeData(data, ret_items * (actual_format / 8));
 	} catch(...) {
 		::XFree(data);
 		throw;
 	}
+
+	return PropertyStatus::OK;
 }
 
 template <typename PROPTYPE>
-void XWindow::setProperty(const AtomID name_atom, const Property<PROPTYPE> &prop) {
-	/*
-	 * NOTE: currently only performs mode PropModeReplace
-	 *
-	 * I don't think that prepend or append are very common use cases.
-	 */
+void XWindow::getProperty(const AtomID name_atom, Property<PROPTYPE> &prop, const PropertyInfo *info) const {
+	QueryDetails details;
+
+	if (const auto status = queryProperty(name_atom, prop, info, details); status != PropertyStatus::OK) {
+		throwQueryError(status, details);
+	}
+}
+
+template <typename PROPTYPE>
+PropertyStatus XWindow::tryGetProperty(const AtomID name_atom, Property<PROPTYPE> &prop, const PropertyInfo *info) const {
+	QueryDetails details;
+	return queryProperty(name_atom, prop, info, details);
+}
+
+template <typename PROPTYPE>
+RequestToken XWindow::setProperty(const AtomID name_atom, const Property<PROPTYPE> &prop, const PropertyMode mode) {
 	// shorthand for our concrete Property object
 	typedef Property<PROPTYPE> THIS_PROP;
 
-	auto x_type = THIS_PROP::getXType();
+	auto x_type = THIS_PROP::getXType(*m_display);
 	assert (x_type != AtomID::INVALID);
 
 	const int siz = THIS_PROP::Traits::numElements(prop.get());
 
+	XPP_MEASURE(*m_display, "XWindow::setProperty");
+	XPP_COUNT_BYTES_SENT(*m_display, siz * (THIS_PROP::Traits::FORMAT / 8));
+
+	const auto first = m_display->nextRequest();
 	const int res = ::XChangeProperty(
-		display,
+		*m_display,
 		rawID(),
 		raw_atom(name_atom),
 		raw_atom(x_type),
 		THIS_PROP::Traits::FORMAT,
-		PropModeReplace,
+		cosmos::to_integral(mode),
 		(unsigned char*)prop.raw(),
 		siz
 	);
@@ -535,58 +784,70 @@ void XWindow::setProperty(const AtomID name_atom, const Property<PROPTYPE> &prop
 	// XChangeProperty returns constantly 1 which would result in
 	// "BadRequest".
 	// Actual errors are dispatched asynchronously via the functions set
-	// at XSetErrorHandler. Not very helpful as hard to process
-	// asynchronously and inefficient to synchronize to the asynchronous
-	// result.
+	// at XSetErrorHandler. The returned token allows to correlate them
+	// via an ErrorChannel.
 	(void)res;
 
 	// requests to the server are not dispatched immediately thus we need
-	// to flush once
-	display.flush();
+	// to flush once, unless a RequestBatch defers this
+	m_display->autoFlush();
+
+	return RequestToken{*m_display, first};
 }
 
-void XWindow::delProperty(const AtomID name_atom) {
-	const auto status = ::XDeleteProperty(display, rawID(), raw_atom(name_atom));
+RequestToken XWindow::delProperty(const AtomID name_atom) {
+	XPP_MEASURE(*m_display, "XWindow::delProperty");
+	const auto first = m_display->nextRequest();
+	const auto status = ::XDeleteProperty(*m_display, rawID(), raw_atom(name_atom));
 
 	if (status == 0) {
-		throw X11Exception{display, status};
+		throw X11Exception{*m_display, status};
 	}
 
 	// see setProperty()
-	display.flush();
+	m_display->autoFlush();
+
+	return RequestToken{*m_display, first};
 }
 
 void XWindow::nextEvent(XEvent &event, const long event_mask) {
-	const auto status = ::XWindowEvent(display, rawID(), event_mask, &event);
+	const auto status = ::XWindowEvent(*m_display, rawID(), event_mask, &event);
 
 	if (status == 0) {
-		throw X11Exception{display, status};
+		throw X11Exception{*m_display, status};
 	}
 }
 
 void XWindow::getAttrs(XWindowAttrs &attrs) {
-	const auto status = ::XGetWindowAttributes(display, rawID(), &attrs);
+	XPP_MEASURE(*m_display, "XWindow::getAttrs");
+	XPP_COUNT_ROUND_TRIP(*m_display);
+	const auto status = ::XGetWindowAttributes(*m_display, rawID(), &attrs);
 
 	// stupid error codes again. A non-zero status on success?
 	if (status == 0) {
-		throw X11Exception{display, status};
+		throw X11Exception{*m_display, status};
 	}
 }
 
-void XWindow::setWindowAttrs(const XSetWindowAttributes &attrs, const WindowAttrMask &mask) {
+RequestToken XWindow::setWindowAttrs(const XSetWindowAttributes &attrs, const WindowAttrMask &mask) {
+	const auto first = m_display->nextRequest();
 	// - the return value is always the 1 here so no need to check
 	// - the attrs are never changed in Xlib so const_cast is safe
-	::XChangeWindowAttributes(display, rawID(), mask.raw(), const_cast<XSetWindowAttributes*>(&attrs));
+	::XChangeWindowAttributes(*m_display, rawID(), mask.raw(), const_cast<XSetWindowAttributes*>(&attrs));
+	return RequestToken{*m_display, first};
 }
 
-void XWindow::moveResize(const XWindowAttrs &attrs) {
+RequestToken XWindow::moveResize(const XWindowAttrs &attrs) {
+	const auto first = m_display->nextRequest();
 	const auto status = ::XMoveResizeWindow(
-		display, rawID(), attrs.x, attrs.y, attrs.width, attrs.height
+		*m_display, rawID(), attrs.x, attrs.y, attrs.width, attrs.height
 	);
 
 	if (status == 0) {
-		throw X11Exception{display, status};
+		throw X11Exception{*m_display, status};
 	}
+
+	return RequestToken{*m_display, first};
 }
 
 void XWindow::updateFamily() {
@@ -597,10 +858,12 @@ void XWindow::updateFamily() {
 	m_children.clear();
 	m_parent = WinID::INVALID;
 
-	const Status res = ::XQueryTree(display, rawID(), &root, &parent, &children, &num_children);
+	XPP_MEASURE(*m_display, "XWindow::updateFamily");
+	XPP_COUNT_ROUND_TRIP(*m_display);
+	const Status res = ::XQueryTree(*m_display, rawID(), &root, &parent, &children, &num_children);
 
 	if (res != 1) {
-		throw X11Exception{display, res};
+		throw X11Exception{*m_display, res};
 	}
 
 	m_parent = WinID{parent};
@@ -612,19 +875,23 @@ void XWindow::updateFamily() {
 	::XFree(children);
 }
 
-void XWindow::copyArea(const GraphicsContext &gc, const PixmapID px,
+RequestToken XWindow::copyArea(const GraphicsContext &gc, const PixmapID px,
 		const Extent &ext, const Coord &src_pos, const Coord &dst_pos) {
+	const auto first = m_display->nextRequest();
 	// does not return synchronous errors
 	(void)::XCopyArea(
-		display, cosmos::to_integral(px), rawID(), gc,
+		*m_display, cosmos::to_integral(px), rawID(), gc,
 		src_pos.x, src_pos.y,
 		ext.width, ext.height,
 		dst_pos.x, dst_pos.y);
+	return RequestToken{*m_display, first};
 }
 
-void XWindow::defineCursor(const XCursor &cursor) {
+RequestToken XWindow::defineCursor(const XCursor &cursor) {
+	const auto first = m_display->nextRequest();
 	// does not return synchronous errors
-	(void)::XDefineCursor(display, raw_win(m_win), cosmos::to_integral(cursor.id()));
+	(void)::XDefineCursor(*m_display, raw_win(m_win), cosmos::to_integral(cursor.id()));
+	return RequestToken{*m_display, first};
 }
 
 /*
@@ -641,9 +908,33 @@ template void XWindow::getProperty(const AtomID, Property<std::vector<WinID> >&,
 template void XWindow::getProperty(const AtomID, Property<std::vector<int> >&, const PropertyInfo*) const;
 template void XWindow::getProperty(const AtomID, Property<std::vector<utf8_string> >&, const PropertyInfo*) const;
 template void XWindow::getProperty(const AtomID, Property<utf8_string>&, const PropertyInfo*) const;
-template void XWindow::setProperty(const AtomID, const Property<const char*>&);
-template void XWindow::setProperty(const AtomID, const Property<int>&);
-template void XWindow::setProperty(const AtomID, const Property<utf8_string>&);
-template void XWindow::setProperty(const AtomID, const Property<AtomID>&);
+template void XWindow::getProperty(const AtomID, Property<PropertyView<int> >&, const PropertyInfo*) const;
+template void XWindow::getProperty(const AtomID, Property<PropertyView<AtomID> >&, const PropertyInfo*) const;
+template void XWindow::getProperty(const AtomID, Property<PropertyView<WinID> >&, const PropertyInfo*) const;
+template void XWindow::getProperty(const AtomID, Property<PropertyView<utf8_string> >&, const PropertyInfo*) const;
+template void XWindow::getProperty(const AtomID, Property<WindowIcons>&, const PropertyInfo*) const;
+template PropertyStatus XWindow::tryGetProperty(const AtomID, Property<int>&, const PropertyInfo*) const;
+template PropertyStatus XWindow::tryGetProperty(const AtomID, Property<const char*>&, const PropertyInfo*) const;
+template PropertyStatus XWindow::tryGetProperty(const AtomID, Property<AtomID>&, const PropertyInfo*) const;
+template PropertyStatus XWindow::tryGetProperty(const AtomID, Property<WinID>&, const PropertyInfo*) const;
+template PropertyStatus XWindow::tryGetProperty(const AtomID, Property<std::vector<AtomID> >&, const PropertyInfo*) const;
+template PropertyStatus XWindow::tryGetProperty(const AtomID, Property<std::vector<WinID> >&, const PropertyInfo*) const;
+template PropertyStatus XWindow::tryGetProperty(const AtomID, Property<std::vector<int> >&, const PropertyInfo*) const;
+template PropertyStatus XWindow::tryGetProperty(const AtomID, Property<std::vector<utf8_string> >&, const PropertyInfo*) const;
+template PropertyStatus XWindow::tryGetProperty(const AtomID, Property<utf8_string>&, const PropertyInfo*) const;
+template PropertyStatus XWindow::tryGetProperty(const AtomID, Property<PropertyView<int> >&, const PropertyInfo*) const;
+template PropertyStatus XWindow::tryGetProperty(const AtomID, Property<PropertyView<AtomID> >&, const PropertyInfo*) const;
+template PropertyStatus XWindow::tryGetProperty(const AtomID, Property<PropertyView<WinID> >&, const PropertyInfo*) const;
+template PropertyStatus XWindow::tryGetProperty(const AtomID, Property<PropertyView<utf8_string> >&, const PropertyInfo*) const;
+template PropertyStatus XWindow::tryGetProperty(const AtomID, Property<WindowIcons>&, const PropertyInfo*) const;
+template RequestToken XWindow::setProperty(const AtomID, const Property<const char*>&, const PropertyMode);
+template RequestToken XWindow::setProperty(const AtomID, const Property<int>&, const PropertyMode);
+template RequestToken XWindow::setProperty(const AtomID, const Property<utf8_string>&, const PropertyMode);
+template RequestToken XWindow::setProperty(const AtomID, const Property<AtomID>&, const PropertyMode);
+template RequestToken XWindow::setProperty(const AtomID, const Property<WinID>&, const PropertyMode);
+template RequestToken XWindow::setProperty(const AtomID, const Property<std::vector<int> >&, const PropertyMode);
+template RequestToken XWindow::setProperty(const AtomID, const Property<std::vector<AtomID> >&, const PropertyMode);
+template RequestToken XWindow::setProperty(const AtomID, const Property<std::vector<WinID> >&, const PropertyMode);
+template RequestToken XWindow::setProperty(const AtomID, const Property<std::vector<utf8_string> >&, const PropertyMode);
 
 } // end ns
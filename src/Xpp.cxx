@@ -8,8 +8,10 @@
 #include <cosmos/error/InternalError.hxx>
 
 // xpp
+#include <xpp/CachedAtom.hxx>
 #include <xpp/XDisplay.hxx>
 #include <xpp/PropertyTraits.hxx>
+#include <xpp/PropertyView.hxx>
 #include <xpp/Xpp.hxx>
 #include <xpp/private/Xpp.hxx>
 
@@ -17,29 +19,34 @@ namespace xpp {
 
 static std::atomic<std::size_t> g_init_counter;
 
-void init(std::optional<cosmos::ILogger*> logger) {
+void init(std::optional<cosmos::ILogger*> logger, const ThreadSafe thread_safe) {
 	if (g_init_counter++ != 0)
 		return;
 
 	// this asks the Xlib to be thread-safe
 	// be careful that this must be the first Xlib call in the process
 	// otherwise it won't work!
-	if (!::XInitThreads()) {
+	if (thread_safe && !::XInitThreads()) {
 		throw cosmos::InternalError{"Error initializing libX11 threads"};
 	}
 
-	// only now initialize global convenience variables
-	xpp::display = XDisplay{};
+	// only now initialize global convenience variables, the display is
+	// opened in place so that it doesn't allocate its own AtomMapper
+	Xpp::openDefaultDisplay();
 	xpp::visual = xpp::display.defaultVisual();
 	xpp::colormap = xpp::display.defaultColormap();
 	xpp::screen = xpp::display.defaultScreen();
 
-	PropertyTraits<utf8_string>::init();
-	PropertyTraits<std::vector<utf8_string>>::init();
-
 	if (logger) {
 		Xpp::getInstance().setLogger(**logger);
 	}
+
+	// resolve all well-known atoms using a single round trip
+	resolve_cached_atoms();
+
+	PropertyTraits<utf8_string>::init();
+	PropertyTraits<std::vector<utf8_string>>::init();
+	PropertyTraits<PropertyView<utf8_string>>::init();
 }
 
 void finish() {
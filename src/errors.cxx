@@ -0,0 +1,103 @@
+// C++
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// cosmos
+#include <cosmos/thread/Mutex.hxx>
+
+// xpp
+#include <xpp/private/errors.hxx>
+
+namespace xpp::errors {
+
+namespace {
+
+	struct Entry {
+		SinkID id;
+		Sink sink;
+	};
+
+	/// Protects the global error handler state below.
+	cosmos::Mutex g_lock;
+	/// Currently registered sinks, the most recent last.
+	std::vector<Entry> g_sinks;
+	SinkID g_next_id = 1;
+	/// Whether error_handler() has been installed yet.
+	bool g_installed = false;
+	/// The Xlib error handler active before the first sink was registered.
+	XErrorHandler g_prev_handler = nullptr;
+
+	int error_handler(Display *dis, XErrorEvent *ev) {
+		XErrorHandler prev = nullptr;
+
+		{
+			cosmos::MutexGuard g{g_lock};
+			bool matched = false;
+
+			// every interested sink gets to see the error, e.g. a
+			// RequestBatch nested in a request watched by an
+			// ErrorChannel must not steal the error from the channel
+			for (auto &entry: g_sinks) {
+				if (entry.sink(dis, *ev))
+					matched = true;
+			}
+
+			if (matched)
+				return 0;
+
+			prev = g_prev_handler;
+		}
+
+		// not ours, pass it on to the original handler
+		return prev ? prev(dis, ev) : 0;
+	}
+
+} // end anon ns
+
+SinkID add_sink(Sink sink) {
+	cosmos::MutexGuard g{g_lock};
+
+	// the handler stays installed once the last sink is removed again.
+	// Restoring the previous handler at that point would discard any
+	// handler the application installed in the meantime.
+	if (!g_installed) {
+		g_prev_handler = ::XSetErrorHandler(&error_handler);
+		g_installed = true;
+	}
+
+	const auto id = g_next_id++;
+	g_sinks.push_back(Entry{id, std::move(sink)});
+	return id;
+}
+
+void remove_sink(const SinkID id) {
+	cosmos::MutexGuard g{g_lock};
+
+	std::erase_if(g_sinks, [id](const Entry &entry) {
+		return entry.id == id;
+	});
+}
+
+RequestCatcher::RequestCatcher(Display *dis) :
+		m_dis{dis} {
+	m_sink = add_sink([this](Display *dis, const XErrorEvent &ev) {
+		return recordError(dis, ev);
+	});
+}
+
+RequestCatcher::~RequestCatcher() {
+	remove_sink(m_sink);
+}
+
+bool RequestCatcher::recordError(Display *dis, const XErrorEvent &ev) {
+	if (dis != m_dis || m_serial == NONE || ev.serial != m_serial)
+		return false;
+
+	if (m_error == Success)
+		m_error = ev.error_code;
+
+	return true;
+}
+
+} // end ns
@@ -0,0 +1,250 @@
+// C
+#include <stdint.h>
+
+// C++
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#	define XPP_TEXT_X86
+#	include <immintrin.h>
+#endif
+
+// xpp
+#include <xpp/text.hxx>
+
+namespace xpp::text {
+
+namespace {
+
+	/// Incremental UTF-8 validation state machine.
+	/**
+	 * This follows the well-formed byte sequences table of the Unicode
+	 * standard, thus overlong encodings, surrogates and code points beyond
+	 * U+10FFFF are rejected.
+	 **/
+	struct Utf8State {
+		/// number of continuation bytes still expected.
+		unsigned pending = 0;
+		/// allowed range of the next continuation byte.
+		uint8_t lo = 0x80;
+		uint8_t hi = 0xBF;
+		bool valid = true;
+
+		void feed(const uint8_t ch) {
+			if (pending != 0) {
+				if (ch < lo || ch > hi) {
+					valid = false;
+					return;
+				}
+
+				lo = 0x80;
+				hi = 0xBF;
+				pending--;
+			} else if (ch < 0x80) {
+				return;
+			} else if (ch >= 0xC2 && ch <= 0xDF) {
+				pending = 1;
+			} else if (ch == 0xE0) {
+				pending = 2;
+				lo = 0xA0;
+			} else if (ch == 0xED) {
+				pending = 2;
+				hi = 0x9F;
+			} else if (ch >= 0xE1 && ch <= 0xEF) {
+				pending = 2;
+			} else if (ch == 0xF0) {
+				pending = 3;
+				lo = 0x90;
+			} else if (ch >= 0xF1 && ch <= 0xF3) {
+				pending = 3;
+			} else if (ch == 0xF4) {
+				pending = 3;
+				hi = 0x8F;
+			} else {
+				valid = false;
+			}
+		}
+
+		/// Returns whether a block can skip validation.
+		/**
+		 * This is the case if it contains ASCII only and no sequence is
+		 * pending, or if the data is already known to be invalid.
+		 **/
+		bool canSkip(const bool ascii) const {
+			return !valid || (ascii && pending == 0);
+		}
+
+		bool finish() const { return valid && pending == 0; }
+	};
+
+	/// Scanner state shared by all implementations.
+	/**
+	 * If SPLIT is false then only the UTF-8 encoding is validated.
+	 **/
+	template <bool SPLIT>
+	struct Scanner {
+		Scanner(const std::string_view _data, std::vector<std::string_view> *_out) :
+				data{_data},
+				out{_out} {
+		}
+
+		/// Records a NUL separator at `pos`.
+		void separator(const size_t pos) {
+			if constexpr (SPLIT) {
+				out->emplace_back(data.data() + start, pos - start);
+				start = pos + 1;
+			}
+		}
+
+		/// Records the separators in an ASCII-only block at `pos` given as a bit mask.
+		void separators(const size_t pos, uint32_t mask) {
+			if constexpr (SPLIT) {
+				while (mask != 0) {
+					separator(pos + __builtin_ctz(mask));
+					mask &= mask - 1;
+				}
+			}
+		}
+
+		/// Processes the bytes in [from, to) one by one.
+		void scalar(const size_t from, const size_t to) {
+			for (size_t pos = from; pos < to; pos++) {
+				const auto ch = static_cast<uint8_t>(data[pos]);
+
+				if (ch == 0) {
+					// a NUL can't be part of a multi-byte sequence
+					if (utf8.pending != 0)
+						utf8.valid = false;
+					separator(pos);
+				} else if (utf8.valid) {
+					utf8.feed(ch);
+				}
+			}
+		}
+
+		bool finish() {
+			if constexpr (SPLIT) {
+				// the last string may lack a terminator
+				if (start < data.size()) {
+					out->emplace_back(data.data() + start, data.size() - start);
+				}
+			}
+
+			return utf8.finish();
+		}
+
+		std::string_view data;
+		std::vector<std::string_view> *out;
+		/// start offset of the current string.
+		size_t start = 0;
+		Utf8State utf8;
+	};
+
+	template <bool SPLIT>
+	void scan_scalar(Scanner<SPLIT> &scanner) {
+		scanner.scalar(0, scanner.data.size());
+	}
+
+#ifdef XPP_TEXT_X86
+	template <bool SPLIT>
+	__attribute__((target("sse2")))
+	void scan_sse2(Scanner<SPLIT> &scanner) {
+		const auto data = scanner.data.data();
+		const auto len = scanner.data.size();
+		const __m128i zero = _mm_setzero_si128();
+		size_t pos = 0;
+
+		for (; pos + 16 <= len; pos += 16) {
+			const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+			// the sign bit is set for all non-ASCII bytes
+			const bool ascii = _mm_movemask_epi8(block) == 0;
+
+			if (scanner.utf8.canSkip(ascii)) {
+				scanner.separators(pos, _mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)));
+			} else {
+				scanner.scalar(pos, pos + 16);
+			}
+		}
+
+		scanner.scalar(pos, len);
+	}
+
+	template <bool SPLIT>
+	__attribute__((target("avx2")))
+	void scan_avx2(Scanner<SPLIT> &scanner) {
+		const auto data = scanner.data.data();
+		const auto len = scanner.data.size();
+		const __m256i zero = _mm256_setzero_si256();
+		size_t pos = 0;
+
+		for (; pos + 32 <= len; pos += 32) {
+			const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+			const bool ascii = _mm256_movemask_epi8(block) == 0;
+
+			if (scanner.utf8.canSkip(ascii)) {
+				scanner.separators(pos, static_cast<uint32_t>(
+						_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, zero))));
+			} else {
+				scanner.scalar(pos, pos + 32);
+			}
+		}
+
+		scanner.scalar(pos, len);
+	}
+#endif
+
+	SimdLevel detect() {
+#ifdef XPP_TEXT_X86
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+			return SimdLevel::AVX2;
+		if (__builtin_cpu_supports("sse2"))
+			return SimdLevel::SSE2;
+#endif
+		return SimdLevel::SCALAR;
+	}
+
+	const SimdLevel g_detected = detect();
+	std::atomic<SimdLevel> g_level = g_detected;
+
+	template <bool SPLIT>
+	bool scan(const std::string_view data, std::vector<std::string_view> *out) {
+		Scanner<SPLIT> scanner{data, out};
+
+		switch (g_level.load(std::memory_order_relaxed)) {
+#ifdef XPP_TEXT_X86
+			case SimdLevel::AVX2: scan_avx2(scanner); break;
+			case SimdLevel::SSE2: scan_sse2(scanner); break;
+#endif
+			default: scan_scalar(scanner); break;
+		}
+
+		return scanner.finish();
+	}
+
+} // end anon ns
+
+SimdLevel detected_simd_level() {
+	return g_detected;
+}
+
+SimdLevel simd_level() {
+	return g_level.load(std::memory_order_relaxed);
+}
+
+SimdLevel set_simd_level(const SimdLevel level) {
+	const auto selected = level > g_detected ? g_detected : level;
+	g_level.store(selected, std::memory_order_relaxed);
+	return selected;
+}
+
+bool split_list(const std::string_view data, std::vector<std::string_view> &out) {
+	out.clear();
+	return scan<true>(data, &out);
+}
+
+bool is_valid_utf8(const std::string_view data) {
+	return scan<false>(data, nullptr);
+}
+
+} // end ns
@@ -1,6 +1,7 @@
 #pragma once
 
 // xpp
+#include <xpp/XDisplay.hxx>
 #include <xpp/Xpp.hxx>
 
 // cosmos
@@ -21,11 +22,16 @@ public: // functions
 
 protected: // functions
 
-	friend void init(std::optional<cosmos::ILogger*>);
+	friend void init(std::optional<cosmos::ILogger*>, const ThreadSafe);
 
 	//! protected constructor to enforce singleton usage
 	Xpp() {};
 
+	/// Opens the connection of the global xpp::display in place.
+	static void openDefaultDisplay() {
+		xpp::display.open(nullptr);
+	}
+
 	cosmos::ILogger& getSomeLogger() {
 		if (!m_logger) {
 			setupNullLogger();
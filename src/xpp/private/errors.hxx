@@ -0,0 +1,85 @@
+#pragma once
+
+/*
+ * Routing of asynchronous X errors to interested parties inside libxpp.
+ */
+
+// C++
+#include <atomic>
+#include <cstddef>
+#include <functional>
+
+// X11
+#include <X11/Xlib.h>
+
+namespace xpp::errors {
+
+/// Receives X errors, returns whether the error belongs to the sink.
+/**
+ * Sinks are invoked from within the Xlib error handler, i.e. with the Xlib
+ * display lock held. They must not call into Xlib themselves. A sink should
+ * only claim errors whose serial lies within the range of requests it is
+ * interested in, other threads may issue requests at the same time.
+ **/
+using Sink = std::function<bool (Display*, const XErrorEvent&)>;
+
+using SinkID = size_t;
+
+/// Registers a new sink and returns an ID for removing it again.
+/**
+ * The first call installs a custom Xlib error handler, which stays
+ * active from then on. Each error is offered to all registered sinks.
+ * Errors that no sink claims are passed on to the error handler that was
+ * active before.
+ **/
+SinkID add_sink(Sink sink);
+
+void remove_sink(const SinkID id);
+
+/// Catches the error of a single request at a time.
+/**
+ * The sink is registered for the lifetime of the object, thus objects
+ * issuing the same kind of request over and over, like Image::getImage(),
+ * don't need to register and remove a sink each time.
+ **/
+class RequestCatcher {
+public: // functions
+
+	explicit RequestCatcher(Display *dis);
+
+	~RequestCatcher();
+
+	RequestCatcher(const RequestCatcher&) = delete;
+	RequestCatcher& operator=(const RequestCatcher&) = delete;
+
+	/// Starts catching the error of the request with the given serial.
+	void expect(const unsigned long serial) {
+		m_error = Success;
+		m_serial = serial;
+	}
+
+	/// Stops catching and returns the code of the error caught, or Success.
+	/**
+	 * The caller needs to have waited for the request's outcome.
+	 **/
+	int finish() {
+		m_serial = NONE;
+		return m_error;
+	}
+
+protected: // functions
+
+	bool recordError(Display *dis, const XErrorEvent &ev);
+
+protected: // data
+
+	/// serial value while no request is expected, serial 0 is never used.
+	static constexpr unsigned long NONE = 0;
+
+	Display *m_dis = nullptr;
+	SinkID m_sink = 0;
+	std::atomic<unsigned long> m_serial = NONE;
+	std::atomic<int> m_error = Success;
+};
+
+} // end ns
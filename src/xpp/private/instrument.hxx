@@ -0,0 +1,116 @@
+#pragma once
+
+/*
+ * Instrumentation points used inside libxpp, see xpp/Instrumentation.hxx.
+ *
+ * Without XPP_INSTRUMENT all macros expand to nothing and their arguments
+ * are not evaluated.
+ */
+
+#ifdef XPP_INSTRUMENT
+
+// C
+#include <stdint.h>
+
+// C++
+#include <array>
+#include <atomic>
+#include <chrono>
+
+// X11
+#include <X11/Xlib.h>
+
+// xpp
+#include <xpp/Instrumentation.hxx>
+#include <xpp/XDisplay.hxx>
+
+namespace xpp::instr {
+
+/// Statistics of a single instrumented wrapper function.
+/**
+ * Sites are static objects that register themselves on construction, thus
+ * recording a call does not require any lookup.
+ **/
+struct Site {
+	explicit Site(const char *_name);
+
+	void record(const uint64_t ns, const uint64_t requests);
+
+	const char *name;
+	std::array<std::atomic<uint64_t>, LatencyHistogram::BUCKETS> buckets{};
+	std::atomic<uint64_t> calls = 0;
+	std::atomic<uint64_t> requests = 0;
+	std::atomic<uint64_t> total_ns = 0;
+	std::atomic<uint64_t> max_ns = 0;
+};
+
+/// Measures the duration and number of requests of a wrapper call.
+class Measurement {
+public:
+	Measurement(Site &site, Display *dis) :
+			m_site{site},
+			m_dis{dis},
+			m_start{std::chrono::steady_clock::now()},
+			m_first_request{dis ? ::XNextRequest(dis) : 0} {
+	}
+
+	~Measurement() {
+		const auto end = std::chrono::steady_clock::now();
+		const auto requests = m_dis ? ::XNextRequest(m_dis) - m_first_request : 0;
+		m_site.record(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_start).count(),
+			requests);
+	}
+
+protected:
+	Site &m_site;
+	Display *m_dis;
+	std::chrono::steady_clock::time_point m_start;
+	unsigned long m_first_request;
+};
+
+/// Protocol counters of a single display.
+struct DisplayCounters {
+	Display *dis = nullptr;
+	/// XNextRequest() value at the last reset.
+	unsigned long request_base = 0;
+	std::atomic<uint64_t> round_trips = 0;
+	std::atomic<uint64_t> flushes = 0;
+	std::atomic<uint64_t> bytes_sent = 0;
+	std::atomic<uint64_t> bytes_received = 0;
+};
+
+/// Returns the counters of `disp`, which are cached in the XDisplay object.
+DisplayCounters& counters_for(const XDisplay &disp);
+
+void count_round_trip(const XDisplay &disp);
+void count_flush(const XDisplay &disp);
+void count_bytes_sent(const XDisplay &disp, const size_t bytes);
+void count_bytes_received(const XDisplay &disp, const size_t bytes);
+/// Drops the counters of a display that is being closed.
+/**
+ * The XDisplay needs to drop its cached pointer to the counters itself.
+ **/
+void forget(Display *dis);
+
+} // end ns
+
+#define XPP_MEASURE(dis, name) \
+	static xpp::instr::Site xpp_instr_site{name}; \
+	xpp::instr::Measurement xpp_instr_measurement{xpp_instr_site, dis}
+#define XPP_COUNT_ROUND_TRIP(dis) xpp::instr::count_round_trip(dis)
+#define XPP_COUNT_FLUSH(dis) xpp::instr::count_flush(dis)
+#define XPP_COUNT_BYTES_SENT(dis, bytes) xpp::instr::count_bytes_sent(dis, bytes)
+#define XPP_COUNT_BYTES_RECEIVED(dis, bytes) xpp::instr::count_bytes_received(dis, bytes)
+#define XPP_INSTR_FORGET(dis) xpp::instr::forget(dis)
+
+#else
+
+#define XPP_MEASURE(dis, name)
+#define XPP_COUNT_ROUND_TRIP(dis) do {} while (false)
+#define XPP_COUNT_FLUSH(dis) do {} while (false)
+#define XPP_COUNT_BYTES_SENT(dis, bytes) do {} while (false)
+#define XPP_COUNT_BYTES_RECEIVED(dis, bytes) do {} while (false)
+#define XPP_INSTR_FORGET(dis) do {} while (false)
+
+#endif
@@ -0,0 +1,87 @@
+#pragma once
+
+// C
+#include <stdint.h>
+#include <stdlib.h>
+
+// C++
+#include <cstring>
+#include <memory>
+#include <new>
+
+// X11
+#include <X11/Xlib-xcb.h>
+#include <xcb/xcb.h>
+
+// xpp
+#include <xpp/XDisplay.hxx>
+
+/**
+ * @file
+ *
+ * Helpers for using XCB on the connection of an XDisplay.
+ *
+ * Xlib has no way to issue a request and to collect its reply at a later
+ * time, every request that needs a reply is a blocking round trip. XCB
+ * supports this via its cookie mechanism. Both APIs can be used on the same
+ * connection. Sequencing of requests is taken care of by libX11.
+ **/
+
+namespace xpp {
+
+/// Returns the XCB connection underlying the given display.
+inline xcb_connection_t* xcb_connection(XDisplay &disp) {
+	return ::XGetXCBConnection(disp);
+}
+
+/// Deleter for memory returned from XCB, which needs to be free()'d.
+struct XcbDeleter {
+	void operator()(void *ptr) const { ::free(ptr); }
+};
+
+/// Owner of XCB reply or error structures.
+template <typename T>
+using XcbPtr = std::unique_ptr<T, XcbDeleter>;
+
+/// Copies property data from an XCB reply into a buffer laid out like Xlib does it.
+/**
+ * Xlib returns format 32 property data as an array of C `long`, while XCB
+ * returns the data in wire format i.e. 32-bit items. Like Xlib does, a zero
+ * byte is appended to the data so that it can be used as a C string.
+ *
+ * The returned buffer is allocated via malloc() and can thus be passed to
+ * XFree() (which only calls free()) e.g. via Property::takeData().
+ *
+ * `size` receives the size of the data in wire format, which is what
+ * Property::takeData() expects.
+ **/
+inline unsigned char* to_xlib_property_data(xcb_get_property_reply_t *reply, unsigned long &size) {
+	const auto length = static_cast<size_t>(::xcb_get_property_value_length(reply));
+	const auto value = ::xcb_get_property_value(reply);
+	unsigned char *ret = nullptr;
+
+	if (reply->format == 32) {
+		const auto items = length / 4;
+		auto data = static_cast<long*>(::malloc(items * sizeof(long) + 1));
+		if (!data)
+			throw std::bad_alloc{};
+		auto wire = static_cast<const int32_t*>(value);
+		// Xlib sign-extends 32-bit items, so do the same
+		for (size_t item = 0; item < items; item++) {
+			data[item] = wire[item];
+		}
+		ret = reinterpret_cast<unsigned char*>(data);
+		ret[items * sizeof(long)] = 0;
+	} else {
+		ret = static_cast<unsigned char*>(::malloc(length + 1));
+		if (!ret)
+			throw std::bad_alloc{};
+		std::memcpy(ret, value, length);
+		ret[length] = 0;
+	}
+
+	size = length;
+	return ret;
+}
+
+} // end ns
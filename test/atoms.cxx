@@ -1,5 +1,7 @@
 // C++
+#include <chrono>
 #include <iostream>
+#include <vector>
 
 // cosmos
 #include <cosmos/cosmos.hxx>
@@ -10,13 +12,51 @@
 #include <xpp/atoms.hxx>
 #include <xpp/CachedAtom.hxx>
 #include <xpp/helpers.hxx>
+#include <xpp/XDisplay.hxx>
 #include <xpp/Xpp.hxx>
 
 constexpr xpp::CachedAtom window_name{"_NET_WM_NAME"};
+constexpr xpp::CachedAtom app_atom{"_XPP_TEST_APP_ATOM"};
+
+/// compares sequential atom resolution against a single bulk request
+void compareBulkResolve() {
+	using Clock = std::chrono::steady_clock;
+	std::vector<cosmos::SysString> names;
+
+	for (const auto atom: xpp::atoms::all) {
+		names.push_back(atom->name().data());
+	}
+
+	auto start = Clock::now();
+	for (const auto &name: names) {
+		(void)xpp::display.mapAtom(name);
+	}
+	const auto sequential = Clock::now() - start;
+
+	xpp::AtomIDVector atoms;
+	start = Clock::now();
+	xpp::display.mapAtoms(names, atoms);
+	const auto bulk = Clock::now() - start;
+
+	using std::chrono::duration_cast;
+	using std::chrono::microseconds;
+
+	std::cout << "resolving " << names.size() << " atoms sequentially took "
+		<< duration_cast<microseconds>(sequential).count() << " µs, in bulk "
+		<< duration_cast<microseconds>(bulk).count() << " µs\n";
+
+	for (size_t num = 0; num < names.size(); num++) {
+		if (atoms[num] != xpp::atoms::all[num]->atom()) {
+			throw std::runtime_error{"bulk resolved atom mismatch"};
+		}
+	}
+}
 
 int main() {
 	cosmos::Init cosmos_init;
 	cosmos::StdLogger logger;
+	// needs to happen before init to take part in the bulk resolve
+	xpp::register_cached_atoms({&app_atom});
 	xpp::Init init(&logger);
 
 	auto id = static_cast<xpp::AtomID>(window_name);
@@ -24,6 +64,19 @@ int main() {
 	std::cout << window_name.name() << " = " << xpp::raw_atom(id) << "\n";
 	const auto &client_machine = xpp::atoms::icccm_client_machine;
 	std::cout << client_machine.name() << " = " << xpp::raw_atom(client_machine) << "\n";
+	std::cout << app_atom.name() << " = " << xpp::raw_atom(app_atom) << "\n";
+
+	if (xpp::atom_mapper.mapName(app_atom) != app_atom.name()) {
+		std::cerr << "reverse lookup of registered atom failed\n";
+		return 1;
+	}
+
+	try {
+		compareBulkResolve();
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
 
 	return 0;
 }
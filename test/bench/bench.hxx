@@ -0,0 +1,132 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Minimal helpers for libxpp benchmark programs.
+ *
+ * Each benchmark program creates a Suite, runs a number of measurements and
+ * finally writes the results as JSON. If the BENCH_OUTPUT environment
+ * variable is set then the JSON is written to the file it names, otherwise
+ * to stdout. Per measurement the number of iterations and min, mean, p50,
+ * p90, p99 and max durations in nanoseconds are reported.
+ **/
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+	std::string name;
+	size_t iterations = 0;
+	double min = 0;
+	double mean = 0;
+	double p50 = 0;
+	double p90 = 0;
+	double p99 = 0;
+	double max = 0;
+};
+
+class Suite {
+public: // functions
+
+	explicit Suite(std::string name) :
+			m_name{std::move(name)} {}
+
+	/// Runs `func` `iterations` times after a short warmup and records the durations.
+	template <typename FUNC>
+	void run(const std::string &name, const size_t iterations, FUNC &&func) {
+		for (size_t i = 0; i < std::max<size_t>(iterations / 10, 1); i++) {
+			func();
+		}
+
+		std::vector<double> samples;
+		samples.reserve(iterations);
+
+		for (size_t i = 0; i < iterations; i++) {
+			const auto start = Clock::now();
+			func();
+			const auto end = Clock::now();
+			samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+		}
+
+		addSamples(name, std::move(samples));
+	}
+
+	/// Records externally measured samples in nanoseconds.
+	void addSamples(const std::string &name, std::vector<double> samples) {
+		if (samples.empty())
+			return;
+
+		std::sort(samples.begin(), samples.end());
+
+		Result res;
+		res.name = name;
+		res.iterations = samples.size();
+		res.min = samples.front();
+		res.max = samples.back();
+		double sum = 0;
+		for (const auto sample: samples)
+			sum += sample;
+		res.mean = sum / samples.size();
+		res.p50 = percentile(samples, 50);
+		res.p90 = percentile(samples, 90);
+		res.p99 = percentile(samples, 99);
+
+		std::cerr << m_name << "/" << name << ": p50 " << res.p50 << " ns, p99 " << res.p99 << " ns\n";
+		m_results.push_back(res);
+	}
+
+	/// Writes the JSON report.
+	void write() const {
+		if (const char *path = std::getenv("BENCH_OUTPUT"); path && *path) {
+			std::ofstream out{path};
+			write(out);
+		} else {
+			write(std::cout);
+		}
+	}
+
+	void write(std::ostream &out) const {
+		out << "{\n  \"suite\": \"" << m_name << "\",\n  \"unit\": \"ns\",\n  \"results\": [\n";
+
+		for (size_t i = 0; i < m_results.size(); i++) {
+			const auto &res = m_results[i];
+			out << "    {\"name\": \"" << res.name << "\""
+				<< ", \"iterations\": " << res.iterations
+				<< ", \"min\": " << res.min
+				<< ", \"mean\": " << res.mean
+				<< ", \"p50\": " << res.p50
+				<< ", \"p90\": " << res.p90
+				<< ", \"p99\": " << res.p99
+				<< ", \"max\": " << res.max << "}"
+				<< (i + 1 < m_results.size() ? ",\n" : "\n");
+		}
+
+		out << "  ]\n}\n";
+	}
+
+protected: // functions
+
+	/// Nearest-rank percentile of sorted samples.
+	static double percentile(const std::vector<double> &sorted, const size_t pct) {
+		const auto rank = (pct * sorted.size() + 99) / 100;
+		return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+	}
+
+protected: // data
+
+	std::string m_name;
+	std::vector<Result> m_results;
+};
+
+} // end ns
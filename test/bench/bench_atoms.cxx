@@ -0,0 +1,46 @@
+// C++
+#include <iostream>
+#include <string>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/AtomMapper.hxx>
+#include <xpp/Xpp.hxx>
+
+// bench
+#include "bench.hxx"
+
+int main() {
+	try {
+		cosmos::Init cosmos_init;
+		cosmos::StdLogger logger;
+		xpp::Init init(&logger);
+
+		bench::Suite suite{"atoms"};
+		auto &mapper = xpp::atom_mapper;
+
+		(void)mapper.mapAtom("_NET_WM_NAME");
+
+		suite.run("mapAtom_hit", 100000, [&]() {
+			(void)mapper.mapAtom("_NET_WM_NAME");
+		});
+
+		size_t counter = 0;
+		std::string name;
+
+		// every iteration creates a new atom in the X server
+		suite.run("mapAtom_miss", 2000, [&]() {
+			name = "XPP_BENCH_ATOM_" + std::to_string(counter++);
+			(void)mapper.mapAtom(name);
+		});
+
+		suite.write();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "benchmark failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,165 @@
+// C++
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// X11
+#include <X11/Xutil.h>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/CaptureRing.hxx>
+#include <xpp/helpers.hxx>
+#include <xpp/RootWin.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindowAttrs.hxx>
+#include <xpp/Xpp.hxx>
+
+// bench
+#include "bench.hxx"
+
+/*
+ * Screen capture throughput of the root window. The Xvfb used for the
+ * benchmarks runs at 1920x1080x24, thus this measures 1080p frames.
+ */
+
+namespace {
+
+constexpr size_t FRAMES = 200;
+
+void report_fps(const std::string &label, const size_t frames, const bench::Clock::duration elapsed) {
+	const auto secs = std::chrono::duration<double>(elapsed).count();
+	std::cerr << "capture/" << label << ": " << (frames / secs) << " fps\n";
+}
+
+/// Simulates an encoder touching every pixel of the frame.
+uint64_t consume(const xpp::Image &image) {
+	uint64_t sum = 0;
+	const auto data = image.data();
+
+	for (size_t pos = 0; pos < data.size(); pos += 64) {
+		sum += data[pos];
+	}
+
+	return sum;
+}
+
+/// Runs `frames` captures via `ring`, consumed in the current thread.
+void run_serial(bench::Suite &suite, const std::string &label, xpp::CaptureRing &ring, uint64_t &checksum) {
+	const auto start = bench::Clock::now();
+	suite.run(label, FRAMES, [&]() {
+		const auto frame = ring.capture();
+		checksum += consume(*frame.image);
+		ring.release(frame);
+	});
+	// the suite runs an additional tenth of iterations for warmup
+	report_fps(label, FRAMES + FRAMES / 10, bench::Clock::now() - start);
+}
+
+/// Captures into `ring` while a separate thread consumes the frames.
+void run_pipelined(bench::Suite &suite, const std::string &label, xpp::CaptureRing &ring, uint64_t &checksum) {
+	std::mutex lock;
+	std::condition_variable cond;
+	std::deque<xpp::CaptureRing::Frame> queue;
+	bool done = false;
+
+	std::thread encoder{[&]() {
+		while (true) {
+			std::unique_lock l{lock};
+			cond.wait(l, [&]() { return done || !queue.empty(); });
+
+			if (queue.empty())
+				break;
+
+			const auto frame = queue.front();
+			queue.pop_front();
+			l.unlock();
+
+			checksum += consume(*frame.image);
+			ring.release(frame);
+		}
+	}};
+
+	std::vector<double> intervals;
+	intervals.reserve(FRAMES);
+	auto last = bench::Clock::now();
+	const auto start = last;
+
+	ring.stream([&](const xpp::CaptureRing::Frame &frame) {
+		intervals.push_back(std::chrono::duration<double, std::nano>(frame.time - last).count());
+		last = frame.time;
+
+		{
+			std::lock_guard l{lock};
+			queue.push_back(frame);
+		}
+		cond.notify_one();
+		return true;
+	}, FRAMES);
+
+	{
+		std::lock_guard l{lock};
+		done = true;
+	}
+	cond.notify_one();
+	encoder.join();
+
+	report_fps(label, FRAMES, bench::Clock::now() - start);
+	suite.addSamples(label, std::move(intervals));
+}
+
+} // end anon ns
+
+int main() {
+	try {
+		cosmos::Init cosmos_init;
+		cosmos::StdLogger logger;
+		xpp::Init init(&logger);
+
+		bench::Suite suite{"capture"};
+		xpp::RootWin root;
+		uint64_t checksum = 0;
+
+		// the plain Xlib way of capturing a frame, allocating each time
+		{
+			xpp::XWindowAttrs attrs;
+			root.getAttrs(attrs);
+			const auto start = bench::Clock::now();
+			suite.run("XGetImage_1080p", FRAMES / 4, [&]() {
+				auto image = ::XGetImage(xpp::display, xpp::raw_win(root.id()),
+						0, 0, attrs.width, attrs.height, AllPlanes, ZPixmap);
+				checksum += static_cast<uint8_t>(image->data[0]);
+				XDestroyImage(image);
+			});
+			report_fps("XGetImage_1080p", FRAMES / 4 + FRAMES / 40, bench::Clock::now() - start);
+		}
+
+		xpp::CaptureRing plain{root, std::nullopt, 3, xpp::CaptureRing::UseShm{false}};
+		run_serial(suite, "ring_plain_1080p", plain, checksum);
+
+		xpp::CaptureRing shared{root, std::nullopt, 3};
+		if (!shared.isShared()) {
+			std::cerr << "MIT-SHM is not available, shared results are plain ones\n";
+		}
+
+		run_serial(suite, "ring_shm_1080p", shared, checksum);
+		run_pipelined(suite, "ring_shm_1080p_pipelined", shared, checksum);
+
+		// thumbnail sized sub-rectangle
+		xpp::CaptureRing thumb{root, xpp::WindowSpec{640, 360, 640, 360}, 3};
+		run_serial(suite, "ring_shm_640x360", thumb, checksum);
+
+		std::cerr << "checksum " << checksum << "\n";
+
+		suite.write();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "benchmark failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
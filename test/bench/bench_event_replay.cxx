@@ -0,0 +1,136 @@
+// C++
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// X11
+#include <X11/Xlib.h>
+
+// xpp
+#include <xpp/EventLoop.hxx>
+#include <xpp/EventRecorder.hxx>
+
+/*
+ * Replays an event recording through EventLoop::dispatch() without an X
+ * server and reports the throughput and the latency per event type.
+ *
+ * usage: bench_event_replay [--original] [RECORDING]
+ *
+ * If no recording is passed then a synthetic event storm is generated.
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t SYNTHETIC_EVENTS = 1000000;
+
+void create_synthetic_recording(const std::string &path) {
+	xpp::EventRecorder recorder{path};
+	XEvent raw{};
+
+	for (size_t num = 0; num < SYNTHETIC_EVENTS; num++) {
+		std::memset(&raw, 0, sizeof(raw));
+		const Window win = 0x200000 + num % 16;
+
+		switch (num % 5) {
+			case 0:
+			case 1:
+				raw.xmotion.type = MotionNotify;
+				raw.xmotion.window = win;
+				raw.xmotion.x = num % 1920;
+				raw.xmotion.y = num % 1080;
+				break;
+			case 2:
+				raw.xconfigure.type = ConfigureNotify;
+				raw.xconfigure.window = win;
+				raw.xconfigure.width = num % 1920;
+				raw.xconfigure.height = num % 1080;
+				break;
+			case 3:
+				raw.xproperty.type = PropertyNotify;
+				raw.xproperty.window = win;
+				raw.xproperty.atom = 300 + num % 8;
+				break;
+			case 4:
+				raw.xclient.type = ClientMessage;
+				raw.xclient.window = win;
+				raw.xclient.format = 32;
+				break;
+		}
+
+		// simulate a storm of 10,000 events per second
+		recorder.record(xpp::Event{raw}, std::chrono::microseconds{num * 100});
+	}
+
+	recorder.flush();
+}
+
+struct Stats {
+	size_t count = 0;
+	Clock::duration total{};
+};
+
+} // end anon ns
+
+int main(int argc, const char **argv) {
+	auto timing = xpp::EventReplay::Timing::FAST;
+	std::string path;
+
+	for (int arg = 1; arg < argc; arg++) {
+		if (std::string{argv[arg]} == "--original") {
+			timing = xpp::EventReplay::Timing::ORIGINAL;
+		} else {
+			path = argv[arg];
+		}
+	}
+
+	try {
+		if (path.empty()) {
+			path = "bench_event_replay.rec";
+			create_synthetic_recording(path);
+		}
+
+		xpp::EventLoop loop{nullptr};
+		std::array<Stats, LASTEvent> stats;
+		// some cheap work for the handlers, to keep them from being optimized out
+		size_t checksum = 0;
+
+		loop.setDefaultHandler([&checksum](const xpp::Event &event) {
+			checksum += event.toAnyEvent().window;
+		});
+
+		xpp::EventReplay replay{path};
+
+		const auto start = Clock::now();
+		const auto events = replay.replay([&](const xpp::Event &event) {
+			const auto before = Clock::now();
+			loop.dispatch(event);
+			auto &stat = stats[static_cast<size_t>(event.type()) % LASTEvent];
+			stat.total += Clock::now() - before;
+			stat.count++;
+		}, timing);
+		const auto elapsed = std::chrono::duration<double>(Clock::now() - start);
+
+		std::cout << "replayed " << events << " events in " << elapsed.count() << " s: "
+			<< static_cast<size_t>(events / elapsed.count()) << " events/s"
+			<< " (checksum " << checksum << ")\n";
+
+		for (size_t type = 0; type < stats.size(); type++) {
+			const auto &stat = stats[type];
+			if (stat.count == 0)
+				continue;
+
+			const auto avg = std::chrono::duration_cast<std::chrono::nanoseconds>(stat.total).count() / stat.count;
+			std::cout << "event type " << type << ": " << stat.count
+				<< " events, " << avg << " ns per handler call\n";
+		}
+
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "benchmark failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,98 @@
+// C++
+#include <iostream>
+#include <vector>
+
+// xpp
+#include <xpp/PropertyTraits.hxx>
+#include <xpp/WindowIcons.hxx>
+
+// bench
+#include "bench.hxx"
+
+/*
+ * Compares _NET_WM_ICON decoding via WindowIcons with the generic
+ * std::vector<int> property path. This doesn't need an X server, the
+ * property data is synthesized in the layout Xlib returns it in.
+ */
+
+namespace {
+
+constexpr size_t ITERATIONS = 2000;
+
+/// The icon sizes a typical toolkit application sets.
+std::vector<long> make_icon_data() {
+	std::vector<long> ret;
+
+	for (const unsigned size: {16, 22, 24, 32, 48, 64, 128, 256}) {
+		ret.push_back(size);
+		ret.push_back(size);
+
+		for (unsigned pixel = 0; pixel < size * size; pixel++) {
+			// a gradient with varying alpha, sign extended like Xlib does
+			const uint32_t argb = (pixel & 0xff) << 24 | (pixel * 0x10101);
+			ret.push_back(static_cast<int32_t>(argb));
+		}
+	}
+
+	return ret;
+}
+
+} // end anon ns
+
+int main() {
+	try {
+		bench::Suite suite{"icons"};
+		const auto data = make_icon_data();
+		// keeps the results from being optimized away
+		size_t checksum = 0;
+
+		std::vector<int> generic;
+		suite.run("vector_int_x2native", ITERATIONS, [&]() {
+			xpp::PropertyTraits<std::vector<int>>::x2native(
+					generic, const_cast<long*>(data.data()), data.size());
+			checksum += generic.back();
+		});
+
+		std::vector<uint32_t> narrowed(data.size());
+		suite.run("narrow_scalar_loop", ITERATIONS, [&]() {
+			for (size_t i = 0; i < data.size(); i++) {
+				narrowed[i] = static_cast<uint32_t>(data[i]);
+			}
+			checksum += narrowed.back();
+		});
+
+		suite.run("narrow_format32", ITERATIONS, [&]() {
+			xpp::narrow_format32(data.data(), data.size(), narrowed.data());
+			checksum += narrowed.back();
+		});
+
+		xpp::WindowIcons icons;
+		suite.run("parse_all", ITERATIONS, [&]() {
+			icons.parse(data.data(), data.size());
+			checksum += icons.size();
+		});
+		const auto all_bytes = icons.pixelBytes();
+
+		suite.run("parse_exact_32", ITERATIONS, [&]() {
+			icons.parse(data.data(), data.size(), xpp::Extent{32, 32});
+			checksum += icons.size();
+		});
+
+		suite.run("parse_downscale_40", ITERATIONS, [&]() {
+			icons.parse(data.data(), data.size(), xpp::Extent{40, 40});
+			checksum += icons.size();
+		});
+		const auto scaled_bytes = icons.pixelBytes();
+
+		std::cerr << "memory: xlib " << data.size() * sizeof(long)
+			<< " bytes, all icons " << all_bytes
+			<< " bytes, downscaled icon " << scaled_bytes << " bytes\n";
+		std::cerr << "checksum " << checksum << "\n";
+
+		suite.write();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "benchmark failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,119 @@
+// C++
+#include <iostream>
+#include <string>
+#include <vector>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/AtomMapper.hxx>
+#include <xpp/atoms.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/PropertyView.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+// bench
+#include "bench.hxx"
+
+namespace {
+
+constexpr size_t ITERATIONS = 5000;
+/// number of items in list properties
+constexpr size_t LIST_ITEMS = 64;
+
+template <typename PROPTYPE>
+void bench_get(bench::Suite &suite, const std::string &name, xpp::XWindow &win, const xpp::AtomID prop) {
+	suite.run("getProperty_" + name, ITERATIONS, [&]() {
+		xpp::Property<PROPTYPE> p;
+		win.getProperty(prop, p);
+	});
+}
+
+template <typename PROPTYPE>
+void bench_set(bench::Suite &suite, const std::string &name, xpp::XWindow &win,
+		const xpp::AtomID prop, const PROPTYPE &value) {
+	const xpp::Property<PROPTYPE> p{value};
+	suite.run("setProperty_" + name, ITERATIONS, [&]() {
+		win.setProperty(prop, p);
+	});
+	xpp::display.sync();
+}
+
+} // end anon ns
+
+int main() {
+	try {
+		cosmos::Init cosmos_init;
+		cosmos::StdLogger logger;
+		xpp::Init init(&logger);
+
+		bench::Suite suite{"properties"};
+		xpp::XWindow win{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+		auto &mapper = xpp::atom_mapper;
+
+		const auto p_int = mapper.mapAtom("XPP_BENCH_INT");
+		const auto p_string = mapper.mapAtom("XPP_BENCH_STRING");
+		const auto p_utf8 = mapper.mapAtom("XPP_BENCH_UTF8");
+		const auto p_atom = mapper.mapAtom("XPP_BENCH_ATOM");
+		const auto p_win = mapper.mapAtom("XPP_BENCH_WINDOW");
+		const auto p_atoms = mapper.mapAtom("XPP_BENCH_ATOM_LIST");
+		const auto p_wins = mapper.mapAtom("XPP_BENCH_WINDOW_LIST");
+		const auto p_ints = mapper.mapAtom("XPP_BENCH_INT_LIST");
+		const auto p_utf8s = mapper.mapAtom("XPP_BENCH_UTF8_LIST");
+
+		const std::string text(256, 'x');
+
+		bench_set(suite, "int", win, p_int, 42);
+		bench_get<int>(suite, "int", win, p_int);
+
+		bench_set(suite, "string", win, p_string, text.c_str());
+		bench_get<const char*>(suite, "string", win, p_string);
+
+		bench_set(suite, "utf8_string", win, p_utf8, xpp::utf8_string{text});
+		bench_get<xpp::utf8_string>(suite, "utf8_string", win, p_utf8);
+
+		bench_set(suite, "AtomID", win, p_atom, xpp::AtomID{xpp::atoms::ewmh_window_name});
+		bench_get<xpp::AtomID>(suite, "AtomID", win, p_atom);
+
+		bench_set(suite, "WinID", win, p_win, win.id());
+		bench_get<xpp::WinID>(suite, "WinID", win, p_win);
+
+		const std::vector<xpp::WinID> wins(LIST_ITEMS, win.id());
+		bench_set(suite, "vector_WinID", win, p_wins, wins);
+		bench_get<std::vector<xpp::WinID>>(suite, "vector_WinID", win, p_wins);
+		bench_get<xpp::PropertyView<xpp::WinID>>(suite, "view_WinID", win, p_wins);
+
+		std::vector<int> ints;
+		for (size_t i = 0; i < LIST_ITEMS; i++) {
+			ints.push_back(static_cast<int>(i));
+		}
+		bench_set(suite, "vector_int", win, p_ints, ints);
+		bench_get<std::vector<int>>(suite, "vector_int", win, p_ints);
+		bench_get<xpp::PropertyView<int>>(suite, "view_int", win, p_ints);
+
+		const std::vector<xpp::AtomID> atoms(LIST_ITEMS, xpp::AtomID{xpp::atoms::ewmh_window_name});
+		bench_set(suite, "vector_AtomID", win, p_atoms, atoms);
+		bench_get<std::vector<xpp::AtomID>>(suite, "vector_AtomID", win, p_atoms);
+		bench_get<xpp::PropertyView<xpp::AtomID>>(suite, "view_AtomID", win, p_atoms);
+
+		std::vector<xpp::utf8_string> names;
+		for (size_t i = 0; i < LIST_ITEMS; i++) {
+			names.push_back(xpp::utf8_string{"desktop " + std::to_string(i)});
+		}
+		bench_set(suite, "vector_utf8_string", win, p_utf8s, names);
+		bench_get<std::vector<xpp::utf8_string>>(suite, "vector_utf8_string", win, p_utf8s);
+		bench_get<xpp::PropertyView<xpp::utf8_string>>(suite, "view_utf8_string", win, p_utf8s);
+
+		win.destroy();
+
+		suite.write();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "benchmark failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,76 @@
+// C++
+#include <cstring>
+#include <iostream>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/Event.hxx>
+#include <xpp/GraphicsContext.hxx>
+#include <xpp/helpers.hxx>
+#include <xpp/Pixmap.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+// bench
+#include "bench.hxx"
+
+int main() {
+	try {
+		cosmos::Init cosmos_init;
+		cosmos::StdLogger logger;
+		xpp::Init init(&logger);
+
+		bench::Suite suite{"requests"};
+		xpp::XWindow win{xpp::display.createWindow({0, 0, 512, 512}, 0)};
+		xpp::display.mapWindow(win);
+		xpp::display.sync();
+
+		XEvent raw;
+		std::memset(&raw, 0, sizeof(raw));
+		raw.xclient.type = ClientMessage;
+		raw.xclient.window = xpp::raw_win(win.id());
+		raw.xclient.message_type = xpp::raw_atom(xpp::atoms::icccm_wm_protocols);
+		raw.xclient.format = 32;
+		const xpp::Event event{raw};
+
+		// sendEvent() flushes, the sync includes the server side processing
+		suite.run("sendEvent", 5000, [&]() {
+			win.sendEvent(event);
+		});
+		suite.run("sendEvent_sync", 2000, [&]() {
+			win.sendEvent(event);
+			xpp::display.sync();
+		});
+
+		xpp::Pixmap pixmap{win.id(), xpp::Extent{512, 512}};
+		XGCValues vals;
+		std::memset(&vals, 0, sizeof(vals));
+		xpp::GraphicsContext gc{xpp::to_drawable(win.id()), xpp::GcOptMask{}, vals};
+
+		for (const unsigned int size: {64u, 512u}) {
+			suite.run("copyArea_" + std::to_string(size), 1000, [&]() {
+				win.copyArea(gc, pixmap.id(), xpp::Extent{size, size});
+				xpp::display.sync();
+			});
+		}
+
+		// drop the queued client messages
+		xpp::Event ev;
+		while (xpp::display.eventsQueued(xpp::QueueMode::AFTER_READING) != 0) {
+			xpp::display.nextEvent(ev);
+		}
+
+		win.destroy();
+
+		suite.write();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "benchmark failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
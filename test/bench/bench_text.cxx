@@ -0,0 +1,165 @@
+// C++
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// xpp
+#include <xpp/text.hxx>
+
+// bench
+#include "bench.hxx"
+
+/*
+ * Compares the vectorized text list decoding against the previous scalar
+ * code paths. This doesn't need an X server, the property data is
+ * synthesized.
+ */
+
+namespace {
+
+constexpr size_t ITERATIONS = 100000;
+
+/// _NET_DESKTOP_NAMES like data: mostly ASCII, some multi-byte names.
+std::string make_desktop_names(const size_t count) {
+	std::string ret;
+
+	for (size_t i = 0; i < count; i++) {
+		switch (i % 4) {
+			case 0: ret += "Desktop " + std::to_string(i + 1); break;
+			case 1: ret += "Mail"; break;
+			case 2: ret += "Entwicklungsumgebung für Projekt " + std::to_string(i); break;
+			case 3: ret += "Музыка"; break;
+		}
+		ret.push_back('\0');
+	}
+
+	return ret;
+}
+
+/// WM_CLASS values of a typical set of client windows.
+std::vector<std::string> make_class_values(const size_t count) {
+	const char *classes[][2] = {
+		{"Navigator", "firefox"},
+		{"xterm", "XTerm"},
+		{"org.gnome.Nautilus", "Org.gnome.Nautilus"},
+		{"libreoffice-writer", "libreoffice-writer"},
+		{"code", "Code"},
+		{"thunderbird", "Thunderbird"}
+	};
+
+	std::vector<std::string> ret;
+
+	for (size_t i = 0; i < count; i++) {
+		const auto &entry = classes[i % std::size(classes)];
+		std::string value{entry[0]};
+		value.push_back('\0');
+		value += entry[1];
+		value.push_back('\0');
+		ret.push_back(value);
+	}
+
+	return ret;
+}
+
+/// The previous splitting code of PropertyTraits<std::vector<utf8_string>>.
+void split_memchr(std::string_view data, std::vector<std::string_view> &out) {
+	out.clear();
+	const char *pos = data.data();
+	size_t count = data.size();
+
+	while (count != 0) {
+		const auto term = static_cast<const char*>(std::memchr(pos, '\0', count));
+		const size_t len = term ? term - pos : count;
+		out.emplace_back(pos, len);
+		const auto consumed = std::min<size_t>(len + 1, count);
+		count -= consumed;
+		pos += consumed;
+	}
+}
+
+/// The previous pointer walk of XWindow::getClass().
+size_t split_class_strlen(const char *clazz) {
+	const auto first = std::strlen(clazz);
+	return first + std::strlen(clazz + first + 1);
+}
+
+const char* level_name(const xpp::text::SimdLevel level) {
+	switch (level) {
+		case xpp::text::SimdLevel::AVX2: return "avx2";
+		case xpp::text::SimdLevel::SSE2: return "sse2";
+		default: return "scalar";
+	}
+}
+
+} // end anon ns
+
+int main() {
+	try {
+		bench::Suite suite{"text"};
+		std::vector<std::string_view> parts;
+		// keeps the results from being optimized away
+		size_t checksum = 0;
+
+		const auto desktops_small = make_desktop_names(8);
+		const auto desktops_large = make_desktop_names(64);
+		const auto classes = make_class_values(200);
+
+		const std::pair<const char*, const std::string*> lists[] = {
+			{"desktop_names_8", &desktops_small},
+			{"desktop_names_64", &desktops_large}
+		};
+
+		for (const auto &[label, data]: lists) {
+			suite.run(std::string{"memchr_"} + label, ITERATIONS, [&]() {
+				split_memchr(*data, parts);
+				checksum += parts.size();
+			});
+
+			// the old path plus a separate validation pass for comparison
+			suite.run(std::string{"memchr_validate_"} + label, ITERATIONS, [&]() {
+				split_memchr(*data, parts);
+				xpp::text::set_simd_level(xpp::text::SimdLevel::SCALAR);
+				for (const auto part: parts) {
+					checksum += xpp::text::is_valid_utf8(part);
+				}
+				xpp::text::set_simd_level(xpp::text::detected_simd_level());
+			});
+		}
+
+		suite.run("strlen_wm_class_200", ITERATIONS / 10, [&]() {
+			for (const auto &value: classes) {
+				checksum += split_class_strlen(value.c_str());
+			}
+		});
+
+		for (auto level = static_cast<int>(xpp::text::detected_simd_level()); level >= 0; level--) {
+			const auto selected = xpp::text::set_simd_level(static_cast<xpp::text::SimdLevel>(level));
+			const std::string suffix{level_name(selected)};
+
+			for (const auto &[label, data]: lists) {
+				suite.run(std::string{"split_list_"} + label + "_" + suffix, ITERATIONS, [&]() {
+					checksum += xpp::text::split_list(*data, parts);
+					checksum += parts.size();
+				});
+			}
+
+			suite.run("split_list_wm_class_200_" + suffix, ITERATIONS / 10, [&]() {
+				for (const auto &value: classes) {
+					xpp::text::split_list(value, parts);
+					checksum += parts.size();
+				}
+			});
+		}
+
+		xpp::text::set_simd_level(xpp::text::detected_simd_level());
+		std::cerr << "checksum " << checksum << "\n";
+
+		suite.write();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "benchmark failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
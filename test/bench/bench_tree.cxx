@@ -0,0 +1,74 @@
+// C++
+#include <iostream>
+#include <string>
+#include <vector>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/RootWin.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+// bench
+#include "bench.hxx"
+
+namespace {
+
+/// Creates `count` windows, groups of ten consisting of a toplevel window and nine children.
+std::vector<xpp::XWindow> create_tree(const size_t count) {
+	std::vector<xpp::XWindow> toplevels;
+	std::optional<xpp::XWindow> parent;
+
+	for (size_t num = 0; num < count; num++) {
+		if (num % 10 == 0) {
+			toplevels.emplace_back(xpp::display.createWindow({0, 0, 10, 10}, 0));
+			parent = toplevels.back();
+		} else {
+			(void)xpp::display.createWindow({0, 0, 5, 5}, 0,
+					xpp::WindowClass::COPY_FROM_PARENT, &*parent);
+		}
+	}
+
+	xpp::display.sync();
+	return toplevels;
+}
+
+} // end anon ns
+
+int main() {
+	try {
+		cosmos::Init cosmos_init;
+		cosmos::StdLogger logger;
+		xpp::Init init(&logger);
+
+		bench::Suite suite{"window_tree"};
+		xpp::RootWin root;
+
+		for (const auto &[windows, iterations]: {
+				std::pair<size_t, size_t>{10, 1000},
+				{1000, 100},
+				{10000, 20}}) {
+			auto toplevels = create_tree(windows);
+
+			suite.run("queryTree_" + std::to_string(windows), iterations, [&]() {
+				root.queryTree();
+			});
+
+			// destroys the children, too
+			for (auto &win: toplevels) {
+				win.destroy();
+			}
+			xpp::display.sync();
+		}
+
+		suite.write();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "benchmark failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,133 @@
+// C++
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/CaptureRing.hxx>
+#include <xpp/GraphicsContext.hxx>
+#include <xpp/helpers.hxx>
+#include <xpp/Image.hxx>
+#include <xpp/Pixmap.hxx>
+#include <xpp/RootWin.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+namespace {
+
+constexpr xpp::Extent EXTENT{64, 48};
+constexpr xpp::WindowSpec AREA{8, 4, 32, 16};
+
+uint32_t pattern(const unsigned x, const unsigned y) {
+	return (x * 4) << 16 | (y * 4) << 8 | 0x33;
+}
+
+void verify(const xpp::CaptureRing::Frame &frame) {
+	const auto &image = *frame.image;
+
+	if (image.bitsPerPixel() != 32)
+		return;
+
+	for (unsigned y = 0; y < AREA.height; y++) {
+		auto row = reinterpret_cast<const uint32_t*>(image.data().data() + y * image.bytesPerLine());
+		for (unsigned x = 0; x < AREA.width; x++) {
+			if ((row[x] & 0xffffff) != pattern(x + AREA.x, y + AREA.y)) {
+				throw std::runtime_error{"captured frame doesn't match source"};
+			}
+		}
+	}
+}
+
+void test_ring(const xpp::Pixmap &pixmap, const bool use_shm) {
+	xpp::CaptureRing ring{xpp::to_drawable(pixmap.id()), AREA, 2, xpp::CaptureRing::UseShm{use_shm}};
+
+	std::cout << "capture uses MIT-SHM: " << (ring.isShared() ? "yes" : "no") << std::endl;
+
+	const auto first = ring.capture();
+	const auto second = ring.capture();
+
+	if (first.sequence != 0 || second.sequence != 1 || first.slot == second.slot) {
+		throw std::runtime_error{"unexpected frame bookkeeping"};
+	}
+
+	verify(first);
+	verify(second);
+
+	// all slots are busy now, capture() needs to wait for the consumer
+	std::thread consumer{[&ring, first]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds{50});
+		ring.release(first);
+	}};
+
+	const auto third = ring.capture();
+	consumer.join();
+
+	if (third.slot != first.slot || third.sequence != 2) {
+		throw std::runtime_error{"released slot was not reused"};
+	}
+
+	ring.release(second);
+	ring.release(third);
+
+	const auto streamed = ring.stream([&ring](const xpp::CaptureRing::Frame &frame) {
+		verify(frame);
+		ring.release(frame);
+		return true;
+	}, 5);
+
+	if (streamed != 5) {
+		throw std::runtime_error{"unexpected number of streamed frames"};
+	}
+}
+
+} // end anon ns
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	xpp::XWindow win{xpp::display.createWindow({0, 0, EXTENT.width, EXTENT.height}, 0)};
+	xpp::Pixmap pixmap{win.id(), EXTENT};
+	xpp::GraphicsContext gc{xpp::to_drawable(pixmap.id()), xpp::GcOptMask{}, XGCValues{}};
+
+	xpp::Image source{EXTENT, xpp::Image::UseShm{false}};
+	if (source.bitsPerPixel() == 32) {
+		for (unsigned y = 0; y < EXTENT.height; y++) {
+			auto row = reinterpret_cast<uint32_t*>(source.row(y));
+			for (unsigned x = 0; x < EXTENT.width; x++) {
+				row[x] = pattern(x, y);
+			}
+		}
+	} else {
+		std::cout << "skipping pixel checks for " << source.bitsPerPixel() << " bits per pixel" << std::endl;
+	}
+	source.putImage(pixmap, gc);
+
+	for (const bool use_shm: {true, false}) {
+		test_ring(pixmap, use_shm);
+	}
+
+	// the root window as a source, like for screen recording
+	xpp::RootWin root;
+	xpp::CaptureRing screen{root, xpp::WindowSpec{0, 0, 16, 16}, 1};
+	screen.release(screen.capture());
+
+	win.destroy();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
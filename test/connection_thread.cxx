@@ -0,0 +1,130 @@
+// C++
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/ConnectionThread.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	// the display is only accessed from the connection thread below
+	xpp::Init init(&logger, xpp::ThreadSafe{false});
+
+	const auto win_id = xpp::display.createWindow({0, 0, 100, 100}, 0);
+
+	xpp::ConnectionThread conn;
+	conn.start();
+
+	constexpr int WORKERS = 4;
+	constexpr int ROUNDS = 100;
+	std::vector<std::thread> workers;
+	std::vector<std::future<int>> results[WORKERS];
+
+	for (int w = 0; w < WORKERS; w++) {
+		workers.emplace_back([&conn, &results, w, win_id]() {
+			for (int i = 0; i < ROUNDS; i++) {
+				const int val = w * ROUNDS + i;
+				results[w].push_back(conn.submit([win_id, val](xpp::XDisplay &disp) {
+					xpp::XWindow win{win_id, disp};
+					win.setProperty(xpp::atoms::ewmh_window_desktop, xpp::Property<int>{val});
+					xpp::Property<int> prop;
+					win.getProperty(xpp::atoms::ewmh_window_desktop, prop);
+					return prop.get();
+				}));
+			}
+		});
+	}
+
+	for (auto &worker: workers) {
+		worker.join();
+	}
+
+	for (int w = 0; w < WORKERS; w++) {
+		for (int i = 0; i < ROUNDS; i++) {
+			// operations run in order, so each one reads back its own value
+			if (results[w][i].get() != w * ROUNDS + i) {
+				throw std::runtime_error{"unexpected property value from connection thread"};
+			}
+		}
+	}
+
+	// exceptions are passed on to the future
+	auto failing = conn.submit([](xpp::XDisplay &) -> int {
+		throw std::runtime_error{"expected failure"};
+	});
+
+	try {
+		failing.get();
+		throw std::runtime_error{"exception was not forwarded"};
+	} catch (const std::runtime_error &ex) {
+		if (std::string{ex.what()} != "expected failure")
+			throw;
+	}
+
+	auto in_thread = conn.submit([&conn](xpp::XDisplay &) {
+		return conn.inConnectionThread();
+	});
+
+	if (!in_thread.get() || conn.inConnectionThread()) {
+		throw std::runtime_error{"inConnectionThread() is off"};
+	}
+
+	// a loop terminated by an exception must not be stopped again by the
+	// stale stop operation left behind by stop() after a restart
+	std::promise<void> failed;
+	conn.submit([&conn, &failed](xpp::XDisplay &) {
+		conn.loop().addTimer(std::chrono::milliseconds{1}, [&failed]() {
+			failed.set_value();
+			throw std::runtime_error{"expected loop failure"};
+		});
+	}).get();
+
+	failed.get_future().wait();
+	conn.stop();
+	conn.start();
+
+	auto restarted = conn.submit([](xpp::XDisplay &) {
+		return true;
+	});
+
+	if (restarted.wait_for(std::chrono::seconds{5}) != std::future_status::ready) {
+		throw std::runtime_error{"connection thread not running after restart"};
+	}
+
+	auto destroyed = conn.submit([win_id](xpp::XDisplay &disp) {
+		xpp::XWindow{win_id, disp}.destroy();
+	});
+	destroyed.get();
+
+	conn.stop();
+
+	if (conn.running()) {
+		throw std::runtime_error{"connection thread still running"};
+	}
+
+	xpp::display.sync();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
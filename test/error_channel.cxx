@@ -0,0 +1,112 @@
+// C++
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/ErrorChannel.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/RequestBatch.hxx>
+#include <xpp/X11Exception.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	xpp::ErrorChannel channel;
+	xpp::XWindow win{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+
+	auto good = channel.watch(win.setProperty(xpp::atoms::ewmh_window_desktop, xpp::Property<int>{1}));
+
+	std::optional<XErrorEvent> bad_error;
+	bool bad_done = false;
+	xpp::XWindow invalid{xpp::WinID{0x7ffffff}};
+	const auto bad_token = invalid.delProperty(xpp::atoms::ewmh_window_desktop);
+
+	if (bad_token.empty()) {
+		throw std::runtime_error{"no requests recorded in token"};
+	}
+
+	channel.watch(bad_token, [&](const std::optional<XErrorEvent> &error) {
+		bad_done = true;
+		bad_error = error;
+	});
+
+	if (channel.pending() != 2) {
+		throw std::runtime_error{"tokens not pending"};
+	}
+
+	// a request with a reply reveals the outcome of all previous requests,
+	// no explicit sync is necessary
+	xpp::Property<int> prop;
+	win.getProperty(xpp::atoms::ewmh_window_desktop, prop);
+
+	if (channel.process() != 2 || channel.pending() != 0) {
+		throw std::runtime_error{"tokens not completed after reply"};
+	}
+
+	good.get();
+
+	if (!bad_done || !bad_error) {
+		throw std::runtime_error{"error of failed request not reported"};
+	}
+
+	std::cout << "failed request reported error code " << int(bad_error->error_code) << "\n";
+
+	// without any reply settle() completes pending tokens
+	auto failing = channel.watch(invalid.delProperty(xpp::atoms::ewmh_window_desktop));
+	channel.settle();
+
+	try {
+		failing.get();
+		throw std::runtime_error{"future of failed request did not throw"};
+	} catch (const xpp::X11Exception &ex) {
+		std::cout << "future reported: " << ex.what() << "\n";
+	}
+
+	// a checking RequestBatch nested into a watched request must not
+	// steal the error from the channel, both need to see it
+	std::optional<XErrorEvent> nested_error;
+	xpp::RequestBatch batch{xpp::RequestBatch::CheckErrors{true}};
+	channel.watch(invalid.delProperty(xpp::atoms::ewmh_window_desktop),
+		[&nested_error](const std::optional<XErrorEvent> &error) {
+			nested_error = error;
+		});
+
+	try {
+		batch.finish();
+		throw std::runtime_error{"checking batch did not throw"};
+	} catch (const xpp::X11Exception &ex) {
+		std::cout << "nested batch reported: " << ex.what() << "\n";
+	}
+
+	if (batch.numErrors() != 1) {
+		throw std::runtime_error{"unexpected number of errors in nested batch"};
+	}
+
+	if (channel.process() != 1 || !nested_error) {
+		throw std::runtime_error{"error of nested batch not reported to channel"};
+	}
+
+	win.destroy();
+	xpp::display.sync();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,81 @@
+// C++
+#include <iostream>
+#include <vector>
+
+// xpp
+#include <xpp/EventCoalescer.hxx>
+
+namespace {
+
+xpp::Event make_property_event(const Window win, const Atom atom) {
+	XEvent raw{};
+	raw.xproperty.type = PropertyNotify;
+	raw.xproperty.window = win;
+	raw.xproperty.atom = atom;
+	return xpp::Event{raw};
+}
+
+xpp::Event make_motion_event(const Window win, const int x) {
+	XEvent raw{};
+	raw.xmotion.type = MotionNotify;
+	raw.xmotion.window = win;
+	raw.xmotion.x = x;
+	return xpp::Event{raw};
+}
+
+xpp::Event make_key_event(const Window win) {
+	XEvent raw{};
+	raw.xkey.type = KeyPress;
+	raw.xkey.window = win;
+	return xpp::Event{raw};
+}
+
+} // end anon ns
+
+void test() {
+	std::vector<xpp::Event> out;
+	xpp::EventCoalescer coalescer{[&out](const xpp::Event &ev) { out.push_back(ev); }};
+	coalescer.setDefaultPolicies();
+
+	// a burst of motion events, interleaved with property changes on two atoms
+	for (int x = 0; x < 100; x++) {
+		coalescer.push(make_motion_event(1, x));
+		coalescer.push(make_property_event(1, 10 + x % 2));
+	}
+
+	// resets the run, the motion event afterwards must not be merged
+	coalescer.push(make_key_event(1));
+	coalescer.push(make_motion_event(1, 1000));
+	coalescer.flush();
+
+	if (out.size() != 5) {
+		throw std::runtime_error{"unexpected number of coalesced events"};
+	}
+
+	// surviving events keep the order of their latest occurrence
+	if (out[0].type() != xpp::EventType::PROPERTY_NOTIFY ||
+			out[1].toPointerMovedEvent().x != 99 ||
+			out[2].type() != xpp::EventType::PROPERTY_NOTIFY ||
+			out[3].type() != xpp::EventType::KEY_PRESS ||
+			out[4].toPointerMovedEvent().x != 1000) {
+		throw std::runtime_error{"unexpected order of coalesced events"};
+	}
+
+	if (coalescer.dropped() != 197 ||
+			coalescer.dropped(xpp::EventType::MOTION_NOTIFY) != 99 ||
+			coalescer.dropped(xpp::EventType::PROPERTY_NOTIFY) != 98) {
+		throw std::runtime_error{"unexpected dropped event counters"};
+	}
+
+	std::cout << "dropped " << coalescer.dropped() << " events\n";
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,76 @@
+// C++
+#include <iostream>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/event/PropertyEvent.hxx>
+#include <xpp/EventLoop.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	xpp::XWindow win{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+	win.selectPropertyNotifyEvent();
+
+	xpp::EventLoop loop;
+	size_t prop_events = 0;
+	size_t ticks = 0;
+
+	loop.setHandler<xpp::PropertyEvent>(xpp::EventType::PROPERTY_NOTIFY,
+		[&](const xpp::PropertyEvent &ev) {
+			if (ev.property() == xpp::atoms::ewmh_window_desktop)
+				prop_events++;
+		});
+
+	loop.addTimer(std::chrono::milliseconds{10}, [&]() {
+		ticks++;
+		win.setProperty(xpp::atoms::ewmh_window_desktop, xpp::Property<int>{static_cast<int>(ticks)});
+	}, std::chrono::milliseconds{10});
+
+	// safety net in case events don't arrive
+	loop.addTimer(std::chrono::seconds{5}, [&]() { loop.stop(); });
+
+	const auto check = loop.addTimer(std::chrono::milliseconds{1}, [&]() {
+		if (prop_events >= 5)
+			loop.stop();
+	}, std::chrono::milliseconds{1});
+
+	loop.run();
+	loop.removeTimer(check);
+
+	if (prop_events < 5) {
+		throw std::runtime_error{"property events were not dispatched"};
+	}
+
+	// dispatching also works for events not coming from the display
+	size_t other_events = 0;
+	loop.setDefaultHandler([&](const xpp::Event&) { other_events++; });
+	xpp::Event fake{xpp::EventType::MAP_NOTIFY};
+	if (!loop.dispatch(fake) || other_events != 1) {
+		throw std::runtime_error{"default handler not invoked"};
+	}
+
+	std::cout << "dispatched " << prop_events << " property events after " << ticks << " timer ticks\n";
+
+	win.destroy();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
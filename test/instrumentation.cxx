@@ -0,0 +1,83 @@
+// C++
+#include <iostream>
+#include <stdexcept>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/Instrumentation.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/XWindowAttrs.hxx>
+#include <xpp/Xpp.hxx>
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	namespace instr = xpp::instrumentation;
+
+	xpp::XWindow win{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+	instr::reset();
+
+	constexpr int ROUNDS = 10;
+
+	for (int i = 0; i < ROUNDS; i++) {
+		win.setProperty(xpp::atoms::ewmh_window_desktop, xpp::Property<int>{i});
+		xpp::Property<int> prop;
+		win.getProperty(xpp::atoms::ewmh_window_desktop, prop);
+		xpp::XWindowAttrs attrs;
+		win.getAttrs(attrs);
+	}
+
+	xpp::display.sync();
+
+	const auto counters = instr::counters(xpp::display);
+	const auto latencies = instr::latencies();
+
+	if (!instr::enabled()) {
+		if (counters.requests != 0 || !latencies.empty()) {
+			throw std::runtime_error{"instrumentation data present in uninstrumented build"};
+		}
+		std::cout << "instrumentation is compiled out\n";
+		win.destroy();
+		return;
+	}
+
+	instr::dump(xpp::display);
+
+	// one round trip each for getProperty and getAttrs, plus the sync
+	if (counters.round_trips < 2 * ROUNDS + 1) {
+		throw std::runtime_error{"missing round trips"};
+	} else if (counters.requests < 3 * ROUNDS) {
+		throw std::runtime_error{"missing requests"};
+	} else if (counters.flushes < ROUNDS) {
+		throw std::runtime_error{"missing flushes"};
+	} else if (counters.bytes_sent != ROUNDS * 4 || counters.bytes_received != ROUNDS * 4) {
+		throw std::runtime_error{"unexpected number of property bytes"};
+	}
+
+	for (const auto name: {"XWindow::getProperty", "XWindow::setProperty", "XWindow::getAttrs"}) {
+		auto it = latencies.find(name);
+		if (it == latencies.end() || it->second.calls != ROUNDS) {
+			throw std::runtime_error{std::string{"missing latencies for "} + name};
+		}
+	}
+
+	win.destroy();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,91 @@
+// C++
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/GraphicsContext.hxx>
+#include <xpp/Pixmap.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/RootWin.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+/*
+ * Operates on a second display connection. If XPP_SECOND_DISPLAY is set
+ * then this display is used, otherwise a second connection to DISPLAY is
+ * opened, which still exercises the per-display code paths.
+ */
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	const char *name = std::getenv("XPP_SECOND_DISPLAY");
+	if (!name || !*name)
+		name = std::getenv("DISPLAY");
+
+	xpp::XDisplay other{name};
+
+	if (&other.atomMapper() == &xpp::atom_mapper) {
+		throw std::runtime_error{"second display shares the default atom cache"};
+	}
+
+	std::cout << "resolved " << xpp::resolve_cached_atoms(other) << " atoms on " << name << "\n";
+
+	xpp::RootWin root{other};
+	xpp::XWindow win{other.createWindow({0, 0, 100, 100}, 0), other};
+
+	if (&win.getDisplay() != &other) {
+		throw std::runtime_error{"window not bound to second display"};
+	}
+
+	// UTF8_STRING is a runtime atom, thus this also checks per-display property types
+	win.setProperty(xpp::atoms::ewmh_window_name, xpp::Property<xpp::utf8_string>{xpp::utf8_string{"other display"}});
+	if (win.getName() != "other display") {
+		throw std::runtime_error{"property roundtrip on second display failed"};
+	}
+
+	const auto utf8 = xpp::atoms::ewmh_utf8_string.atom(other);
+	if (other.atomMapper().mapName(utf8) != "UTF8_STRING") {
+		throw std::runtime_error{"bad atom mapping on second display"};
+	}
+
+	xpp::Pixmap pm{win.id(), xpp::Extent{10, 10}, std::nullopt, other};
+	XGCValues vals{};
+	xpp::GraphicsContext gc{xpp::to_drawable(root.id()), xpp::GcOptMask{}, vals, other};
+
+	gc.destroy();
+	pm.destroy();
+	win.destroy();
+	other.sync();
+
+	// displays created without a connection and moved-to displays
+	// allocate their atom cache on demand
+	xpp::XDisplay moved{std::move(other)};
+	if (moved.atomMapper().mapName(utf8) != "UTF8_STRING") {
+		throw std::runtime_error{"bad atom mapping on moved display"};
+	}
+
+	xpp::XDisplay empty{xpp::XDisplay::Initialize{false}};
+	if (&empty.atomMapper() == &moved.atomMapper()) {
+		throw std::runtime_error{"unconnected display shares an atom cache"};
+	}
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,67 @@
+// C++
+#include <iostream>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/PropertyBatch.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	xpp::XWindow win{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+
+	win.setName("batch test");
+	win.setProperty(xpp::atoms::ewmh_window_desktop, xpp::Property<int>{3});
+
+	xpp::Property<xpp::utf8_string> name;
+	xpp::Property<int> desktop;
+	xpp::Property<int> pid;
+	xpp::Property<int> bad_type;
+
+	xpp::PropertyBatch batch;
+	const auto name_item = batch.add(win.id(), xpp::atoms::ewmh_window_name, name);
+	const auto desktop_item = batch.add(win.id(), xpp::atoms::ewmh_window_desktop, desktop);
+	const auto pid_item = batch.add(win.id(), xpp::atoms::ewmh_window_pid, pid);
+	const auto bad_item = batch.add(win.id(), xpp::atoms::ewmh_window_name, bad_type);
+
+	batch.fetch();
+
+	if (batch.status(name_item) != xpp::PropertyStatus::OK || name.get().str != "batch test") {
+		throw std::runtime_error{"failed to batch-fetch window name"};
+	}
+
+	if (batch.status(desktop_item) != xpp::PropertyStatus::OK || desktop.get() != 3) {
+		throw std::runtime_error{"failed to batch-fetch window desktop"};
+	}
+
+	if (batch.status(pid_item) != xpp::PropertyStatus::NOT_EXISTING) {
+		throw std::runtime_error{"unexpected status for non-existing property"};
+	}
+
+	if (batch.status(bad_item) != xpp::PropertyStatus::TYPE_MISMATCH) {
+		throw std::runtime_error{"unexpected status for mismatching property type"};
+	}
+
+	std::cout << "batch-fetched name \"" << name.get().str << "\" and desktop " << desktop.get() << "\n";
+
+	win.destroy();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,81 @@
+// C++
+#include <iostream>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/Event.hxx>
+#include <xpp/PropertyCache.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+void process_events(xpp::PropertyCache &cache) {
+	xpp::Event event;
+	xpp::display.sync();
+
+	while (xpp::display.hasPendingEvents()) {
+		xpp::display.nextEvent(event);
+		cache.processEvent(event);
+	}
+}
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	xpp::XWindow win{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+	win.setProperty(xpp::atoms::ewmh_window_desktop, xpp::Property<int>{3});
+
+	xpp::PropertyCache cache;
+
+	for (size_t i = 0; i < 10; i++) {
+		if (cache.get<int>(win, xpp::atoms::ewmh_window_desktop) != 3) {
+			throw std::runtime_error{"bad cached desktop value"};
+		}
+	}
+
+	if (cache.stats().misses != 1 || cache.stats().hits != 9) {
+		throw std::runtime_error{"unexpected cache statistics"};
+	}
+
+	win.setProperty(xpp::atoms::ewmh_window_desktop, xpp::Property<int>{5});
+	process_events(cache);
+
+	if (cache.contains(win.id(), xpp::atoms::ewmh_window_desktop)) {
+		throw std::runtime_error{"entry not invalidated by PropertyNotify"};
+	}
+
+	if (cache.get<int>(win, xpp::atoms::ewmh_window_desktop) != 5) {
+		throw std::runtime_error{"bad refreshed desktop value"};
+	}
+
+	win.setName("cache test");
+	process_events(cache);
+	cache.setMaxBytes(1);
+	cache.get<xpp::utf8_string>(win, xpp::atoms::ewmh_window_name);
+
+	if (cache.size() != 1 || cache.stats().evictions != 1) {
+		throw std::runtime_error{"LRU eviction did not happen"};
+	}
+
+	std::cout << "hits: " << cache.stats().hits << ", misses: " << cache.stats().misses
+		<< ", evictions: " << cache.stats().evictions
+		<< ", invalidations: " << cache.stats().invalidations << "\n";
+
+	win.destroy();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,70 @@
+// C++
+#include <iostream>
+#include <string>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/PropertyReader.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	xpp::XWindow win{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+
+	// larger than the default request size of getProperty()
+	std::string large;
+	for (size_t i = 0; large.size() < 300 * 1024; i++) {
+		large += std::to_string(i);
+	}
+
+	win.setProperty(xpp::atoms::ewmh_window_name,
+		xpp::Property<xpp::utf8_string>{xpp::utf8_string{large}});
+
+	xpp::Property<xpp::utf8_string> name;
+	win.getProperty(xpp::atoms::ewmh_window_name, name);
+
+	if (name.get().str != large) {
+		throw std::runtime_error{"failed to read large property"};
+	}
+
+	xpp::PropertyReader reader{win, xpp::atoms::ewmh_window_name, 16 * 1024, 4};
+	xpp::RawProperty chunk;
+	std::string streamed;
+	size_t chunks = 0;
+
+	while (reader.next(chunk)) {
+		if (chunk.offset != streamed.size()) {
+			throw std::runtime_error{"unexpected chunk offset"};
+		}
+		streamed.append(chunk.view());
+		chunks++;
+	}
+
+	if (streamed != large || reader.totalBytes() != large.size()) {
+		throw std::runtime_error{"streamed property data differs"};
+	}
+
+	std::cout << "streamed " << streamed.size() << " bytes in " << chunks << " chunks\n";
+
+	win.destroy();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,83 @@
+// C++
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/PropertyKey.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+namespace {
+
+constexpr xpp::PropertyKey<"_NET_WM_NAME", xpp::utf8_string> net_wm_name;
+constexpr xpp::PropertyKey<"_NET_WM_DESKTOP", int> net_wm_desktop;
+constexpr xpp::PropertyKey<"_XPP_TEST_KEY", const char*> test_key;
+
+static_assert(net_wm_name.name() == "_NET_WM_NAME");
+static_assert(!net_wm_name.STATIC_X_TYPE);
+static_assert(net_wm_desktop.STATIC_X_TYPE);
+
+} // end anon ns
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	xpp::XWindow win{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+
+	if (net_wm_name.atomFor(xpp::display) != xpp::atoms::ewmh_window_name) {
+		throw std::runtime_error{"PropertyKey resolved to wrong atom"};
+	}
+
+	win.setProperty(net_wm_desktop, xpp::Property<int>{2});
+	win.setProperty(net_wm_name, xpp::Property<xpp::utf8_string>{xpp::utf8_string{"keyed"}});
+	win.setProperty(test_key, xpp::Property<const char*>{"custom"});
+
+	xpp::Property<int> desktop;
+	win.getProperty(net_wm_desktop, desktop);
+	if (desktop.get() != 2) {
+		throw std::runtime_error{"keyed int property mismatch"};
+	}
+
+	if (win.getName() != "keyed") {
+		throw std::runtime_error{"keyed utf8 property mismatch"};
+	}
+
+	xpp::Property<const char*> custom;
+	if (win.tryGetProperty(test_key, custom) != xpp::PropertyStatus::OK || std::string_view{custom.get()} != "custom") {
+		throw std::runtime_error{"keyed custom property mismatch"};
+	}
+
+	// the same name used via the string API now hits the AtomMapper cache
+	xpp::Property<const char*> by_name;
+	win.getProperty("_XPP_TEST_KEY", by_name);
+	if (std::string_view{by_name.get()} != "custom") {
+		throw std::runtime_error{"name based lookup mismatch"};
+	}
+
+	win.delProperty(test_key);
+	if (win.tryGetProperty(test_key, custom) != xpp::PropertyStatus::NOT_EXISTING) {
+		throw std::runtime_error{"keyed property not deleted"};
+	}
+
+	win.destroy();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
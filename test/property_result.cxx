@@ -0,0 +1,82 @@
+// C++
+#include <iostream>
+#include <stdexcept>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/PropertyResult.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	xpp::XWindow win{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+
+	// a fresh window carries none of these
+	if (auto pid = win.tryGetPID(); pid || pid.status() != xpp::PropertyStatus::NOT_EXISTING) {
+		throw std::runtime_error{"PID reported for fresh window"};
+	}
+
+	if (win.tryGetName().status() != xpp::PropertyStatus::NOT_EXISTING) {
+		throw std::runtime_error{"name reported for fresh window"};
+	}
+
+	if (win.tryGetClass() || win.tryGetDesktop().valueOr(-1) != -1) {
+		throw std::runtime_error{"unexpected property values for fresh window"};
+	}
+
+	win.setProperty(xpp::atoms::ewmh_window_desktop, xpp::Property<int>{3});
+
+	if (auto desktop = win.tryGetDesktop(); !desktop || *desktop != 3) {
+		throw std::runtime_error{"desktop not retrieved"};
+	}
+
+	xpp::Property<xpp::AtomID> wrong_type;
+	if (win.tryGetProperty(xpp::atoms::ewmh_window_desktop, wrong_type) != xpp::PropertyStatus::TYPE_MISMATCH) {
+		throw std::runtime_error{"type mismatch not detected"};
+	}
+
+	win.setProperty(xpp::atoms::icccm_window_name, xpp::Property<const char*>{"plain name"});
+
+	if (win.tryGetName().value() != "plain name") {
+		throw std::runtime_error{"ICCCM name fallback failed"};
+	}
+
+	xpp::XWindow::PropertyInfo info;
+	if (win.tryGetPropertyInfo(xpp::atoms::ewmh_window_pid, info) != xpp::PropertyStatus::NOT_EXISTING) {
+		throw std::runtime_error{"info reported for missing property"};
+	}
+
+	if (win.tryGetPropertyInfo(xpp::atoms::ewmh_window_desktop, info) != xpp::PropertyStatus::OK ||
+			info.format != 32) {
+		throw std::runtime_error{"info for existing property not retrieved"};
+	}
+
+	// the throwing variants still report the details
+	try {
+		win.getPID();
+		throw std::runtime_error{"getPID() did not throw"};
+	} catch (const xpp::XWindow::PropertyNotExisting &) {
+	}
+
+	win.destroy();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,97 @@
+// C++
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/PropertyKey.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+namespace {
+
+constexpr xpp::PropertyKey<"_XPP_TEST_WINDOWS", std::vector<xpp::WinID>> test_windows;
+constexpr xpp::PropertyKey<"_XPP_TEST_ATOMS", std::vector<xpp::AtomID>> test_atoms;
+constexpr xpp::PropertyKey<"_XPP_TEST_INTS", std::vector<int>> test_ints;
+constexpr xpp::PropertyKey<"_XPP_TEST_STRINGS", std::vector<xpp::utf8_string>> test_strings;
+
+template <typename KEY>
+auto read_back(const xpp::XWindow &win, const KEY key) {
+	typename KEY::PropertyType prop;
+	win.getProperty(key, prop);
+	return prop.get();
+}
+
+} // end anon ns
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	xpp::XWindow win{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+	const std::vector<xpp::WinID> windows{win.id(), xpp::WinID{0x1234}};
+
+	win.setProperty(test_windows, xpp::Property<std::vector<xpp::WinID>>{windows});
+	if (read_back(win, test_windows) != windows) {
+		throw std::runtime_error{"window list mismatch"};
+	}
+
+	// negative values check the conversion to long
+	const std::vector<int> ints{1, -2, 3};
+	xpp::Property<std::vector<int>> int_prop{ints};
+	win.setProperty(test_ints, int_prop);
+	if (read_back(win, test_ints) != ints) {
+		throw std::runtime_error{"int list mismatch"};
+	}
+
+	// reassignment reuses the conversion buffer
+	int_prop = std::vector<int>{4, 5};
+	win.appendProperty(test_ints, int_prop);
+	if (read_back(win, test_ints) != std::vector<int>{1, -2, 3, 4, 5}) {
+		throw std::runtime_error{"appended int list mismatch"};
+	}
+
+	const xpp::AtomID first = xpp::atoms::ewmh_window_name;
+	const xpp::AtomID second = xpp::atoms::ewmh_window_pid;
+	win.setProperty(test_atoms, xpp::Property<std::vector<xpp::AtomID>>{{second}});
+	win.prependProperty(test_atoms, xpp::Property<std::vector<xpp::AtomID>>{{first}});
+	if (read_back(win, test_atoms) != std::vector<xpp::AtomID>{first, second}) {
+		throw std::runtime_error{"prepended atom list mismatch"};
+	}
+
+	// an empty list is a valid property value, too
+	win.setProperty(test_atoms, xpp::Property<std::vector<xpp::AtomID>>{{}});
+	xpp::XWindow::PropertyInfo info;
+	win.getPropertyInfo(test_atoms.atomFor(xpp::display), info);
+	if (info.items != 0 || info.type != xpp::AtomID{XA_ATOM}) {
+		throw std::runtime_error{"empty atom list mismatch"};
+	}
+
+	const std::vector<xpp::utf8_string> strings{xpp::utf8_string{"one"}, xpp::utf8_string{""}, xpp::utf8_string{"three"}};
+	win.setProperty(test_strings, xpp::Property<std::vector<xpp::utf8_string>>{strings});
+	win.appendProperty(test_strings, xpp::Property<std::vector<xpp::utf8_string>>{{xpp::utf8_string{"four"}}});
+	const auto got = read_back(win, test_strings);
+	if (got.size() != 4 || got[0].str != "one" || !got[1].str.empty() || got[3].str != "four") {
+		throw std::runtime_error{"string list mismatch"};
+	}
+
+	win.destroy();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -1,6 +1,12 @@
+#include <algorithm>
 #include <iostream>
+#include <string_view>
+#include <vector>
 
 #include <xpp/AtomMapper.hxx>
+#include <xpp/atoms.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/PropertyView.hxx>
 #include <xpp/Xpp.hxx>
 #include <xpp/RootWin.hxx>
 #include <xpp/types.hxx>
@@ -42,6 +48,39 @@ void getRawProp(xpp::RootWin root_win, xpp::AtomID prop, const xpp::XWindow::Pro
 	printInfo(raw_info, mapper);
 }
 
+void testViews() {
+	xpp::XWindow win{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+
+	using namespace std::string_view_literals;
+	win.setProperty(xpp::atoms::ewmh_wm_desktop_names,
+		xpp::Property<xpp::utf8_string>{xpp::utf8_string{"first\0second"sv}});
+	win.setProperty(xpp::atoms::ewmh_wm_window_type,
+		xpp::Property<xpp::AtomID>{xpp::atoms::ewmh_utf8_string});
+
+	xpp::Property<xpp::PropertyView<xpp::utf8_string>> names;
+	win.getProperty(xpp::atoms::ewmh_wm_desktop_names, names);
+
+	std::vector<std::string_view> expected{"first", "second"};
+	if (!std::equal(names.get().begin(), names.get().end(), expected.begin(), expected.end())) {
+		throw std::runtime_error{"bad string list view"};
+	}
+
+	// a default constructed view has no data at all
+	const xpp::PropertyView<xpp::utf8_string> empty;
+	if (empty.begin() != empty.end()) {
+		throw std::runtime_error{"empty string list view not empty"};
+	}
+
+	xpp::Property<xpp::PropertyView<xpp::AtomID>> types;
+	win.getProperty(xpp::atoms::ewmh_wm_window_type, types);
+
+	if (types.get().size() != 1 || types.get()[0] != xpp::atoms::ewmh_utf8_string) {
+		throw std::runtime_error{"bad atom list view"};
+	}
+
+	win.destroy();
+}
+
 void test() {
 	cosmos::Init cosmos_init;
 	cosmos::StdLogger logger;
@@ -68,6 +107,8 @@ void test() {
 	if (!found) {
 		std::cout << "no suitable properties found on root window!";
 	}
+
+	testViews();
 }
 
 int main() {
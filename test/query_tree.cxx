@@ -0,0 +1,119 @@
+// C++
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+
+// X11
+#include <X11/Xlib.h>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/helpers.hxx>
+#include <xpp/RootWin.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+namespace {
+
+/// Returns the children of `win` as reported by a plain XQueryTree() call.
+std::set<xpp::WinID> query_children(const xpp::WinID win) {
+	Window root = 0, parent = 0;
+	Window *children = nullptr;
+	unsigned int num_children = 0;
+
+	if (::XQueryTree(xpp::display, xpp::raw_win(win), &root, &parent, &children, &num_children) == 0) {
+		throw std::runtime_error{"XQueryTree failed"};
+	}
+
+	std::set<xpp::WinID> ret;
+	for (unsigned int child = 0; child < num_children; child++) {
+		ret.insert(xpp::WinID{children[child]});
+	}
+
+	if (children) {
+		::XFree(children);
+	}
+
+	return ret;
+}
+
+void check_parent(const xpp::RootWin &root, const xpp::WinID win, const xpp::WinID parent) {
+	const auto &tree = root.windowTree();
+	const auto &parents = root.windowParents();
+
+	if (std::find(tree.begin(), tree.end(), win) == tree.end()) {
+		throw std::runtime_error{"window missing in windowTree()"};
+	}
+
+	auto it = parents.find(win);
+	if (it == parents.end() || it->second != parent) {
+		throw std::runtime_error{"wrong parent in windowParents()"};
+	}
+}
+
+} // end anon ns
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	// a small nested tree: top -> child -> {grandchild1, grandchild2}
+	xpp::XWindow top{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+	xpp::XWindow child{top.createChild()};
+	const auto grandchild1 = child.createChild();
+	const auto grandchild2 = child.createChild();
+	xpp::display.sync();
+
+	xpp::RootWin root;
+	root.queryTree();
+
+	const auto &tree = root.windowTree();
+	const auto &parents = root.windowParents();
+
+	if (tree.empty() || tree.front() != root.id()) {
+		throw std::runtime_error{"windowTree() doesn't start with the root window"};
+	} else if (parents.find(root.id()) != parents.end()) {
+		throw std::runtime_error{"root window contained in windowParents()"};
+	}
+
+	check_parent(root, top.id(), root.id());
+	check_parent(root, child.id(), top.id());
+	check_parent(root, grandchild1, child.id());
+	check_parent(root, grandchild2, child.id());
+
+	// the pipelined breadth-first traversal needs to match XQueryTree()
+	// on every level
+	for (const auto win: {root.id(), top.id(), child.id(), grandchild1}) {
+		const auto expected = query_children(win);
+		std::set<xpp::WinID> found;
+		for (const auto &[candidate, parent]: parents) {
+			if (parent == win)
+				found.insert(candidate);
+		}
+
+		if (found != expected) {
+			throw std::runtime_error{"children in windowParents() don't match XQueryTree()"};
+		}
+	}
+
+	std::cout << "queried " << tree.size() << " windows\n";
+
+	top.destroy();
+	xpp::display.sync();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,93 @@
+// C++
+#include <iostream>
+#include <stdexcept>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/Instrumentation.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/RequestBatch.hxx>
+#include <xpp/X11Exception.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	xpp::XWindow win{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+	xpp::display.sync();
+	xpp::instrumentation::reset();
+
+	{
+		xpp::RequestBatch outer;
+
+		for (int i = 0; i < 50; i++) {
+			win.setProperty(xpp::atoms::ewmh_window_desktop, xpp::Property<int>{i});
+		}
+
+		{
+			xpp::RequestBatch inner;
+			win.delProperty(xpp::atoms::ewmh_window_desktop);
+		}
+
+		if (!xpp::display.isBatching()) {
+			throw std::runtime_error{"inner batch ended outer batch"};
+		}
+
+		win.setProperty(xpp::atoms::ewmh_window_desktop, xpp::Property<int>{4711});
+	}
+
+	if (xpp::display.isBatching()) {
+		throw std::runtime_error{"batch still active"};
+	}
+
+	if (xpp::instrumentation::enabled()) {
+		const auto flushes = xpp::instrumentation::counters(xpp::display).flushes;
+		if (flushes != 1) {
+			throw std::runtime_error{"expected a single flush, got " + std::to_string(flushes)};
+		}
+	}
+
+	xpp::Property<int> prop;
+	win.getProperty(xpp::atoms::ewmh_window_desktop, prop);
+	if (prop.get() != 4711) {
+		throw std::runtime_error{"batched requests were not applied"};
+	}
+
+	// a checked batch without errors
+	{
+		xpp::RequestBatch batch{xpp::RequestBatch::CheckErrors{true}};
+		win.setProperty(xpp::atoms::ewmh_window_desktop, xpp::Property<int>{1});
+		batch.finish();
+	}
+
+	// a checked batch with a request that is bound to fail
+	try {
+		xpp::RequestBatch batch{xpp::RequestBatch::CheckErrors{true}};
+		xpp::XWindow invalid{xpp::WinID{0x7ffffff}};
+		invalid.delProperty(xpp::atoms::ewmh_window_desktop);
+		batch.finish();
+		throw std::runtime_error{"error in checked batch went unnoticed"};
+	} catch (const xpp::X11Exception &ex) {
+		std::cout << "checked batch reported: " << ex.what() << "\n";
+	}
+
+	win.destroy();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
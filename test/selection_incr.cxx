@@ -0,0 +1,135 @@
+// C++
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+
+// X11
+#include <X11/Xlib.h>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/Event.hxx>
+#include <xpp/event/SelectionRequestEvent.hxx>
+#include <xpp/helpers.hxx>
+#include <xpp/SelectionReceiver.hxx>
+#include <xpp/SelectionSender.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+namespace {
+
+constexpr size_t CHUNK_SIZE = 64 * 1024;
+constexpr size_t TRANSFER_SIZE = 5 * 1024 * 1024;
+
+char pattern(const size_t pos) {
+	return static_cast<char>('a' + pos % 26);
+}
+
+/// Returns the events this client selected on `win`.
+long selected_events(const xpp::XWindow &win) {
+	XWindowAttributes attrs;
+
+	if (::XGetWindowAttributes(xpp::display, xpp::raw_win(win.id()), &attrs) == 0) {
+		throw std::runtime_error{"XGetWindowAttributes failed"};
+	}
+
+	return attrs.your_event_mask;
+}
+
+/// Transfers `size` bytes to `requestor` via `sender`, returns whether INCR was used.
+bool transfer(xpp::XWindow &requestor, xpp::SelectionSender &sender, const size_t size) {
+	xpp::SelectionReceiver receiver{requestor};
+
+	size_t sent = 0;
+	size_t received = 0;
+	bool corrupted = false;
+	bool incremental = false;
+
+	receiver.request(xpp::atoms::clipboard, xpp::atoms::ewmh_utf8_string,
+		xpp::atoms::clipboard, [&](std::string_view data) {
+			for (const auto ch: data) {
+				if (ch != pattern(received++))
+					corrupted = true;
+			}
+		});
+
+	xpp::Event event;
+
+	while (!receiver.finished()) {
+		xpp::display.nextEvent(event);
+
+		if (event.isSelectionRequest()) {
+			sender.serve(xpp::SelectionRequestEvent{event}, xpp::atoms::ewmh_utf8_string,
+				[&](char *buf, size_t max) {
+					size_t num = 0;
+					for (; num < max && sent < size; num++) {
+						buf[num] = pattern(sent++);
+					}
+					return num;
+				}, size);
+			incremental = sender.activeTransfers() != 0;
+			continue;
+		}
+
+		sender.processEvent(event);
+		receiver.processEvent(event);
+	}
+
+	if (receiver.state() != xpp::SelectionReceiver::State::DONE) {
+		throw std::runtime_error{"selection transfer was refused"};
+	} else if (received != size || corrupted) {
+		throw std::runtime_error{"selection data was not correctly transferred"};
+	}
+
+	return incremental;
+}
+
+} // end anon ns
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	xpp::XWindow owner{xpp::display.createWindow({0, 0, 10, 10}, 0)};
+	xpp::XWindow requestor{xpp::display.createWindow({0, 0, 10, 10}, 0)};
+
+	owner.makeSelectionOwner(xpp::atoms::clipboard);
+
+	// use small chunks to enforce an incremental transfer
+	xpp::SelectionSender sender{CHUNK_SIZE};
+
+	// events selected by the application need to survive the transfer
+	requestor.mergeEventSelection(xpp::EventSelectionMask{xpp::EventMask::KEY_PRESSES});
+
+	if (!transfer(requestor, sender, TRANSFER_SIZE)) {
+		throw std::runtime_error{"large transfer was not incremental"};
+	} else if (selected_events(requestor) != KeyPressMask) {
+		throw std::runtime_error{"event selection not restored after transfer"};
+	}
+
+	std::cout << "transferred " << TRANSFER_SIZE << " bytes incrementally\n";
+
+	// data of exactly one chunk still fits into a single request
+	if (transfer(requestor, sender, CHUNK_SIZE)) {
+		throw std::runtime_error{"transfer of a single chunk was incremental"};
+	}
+
+	owner.destroy();
+	requestor.destroy();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
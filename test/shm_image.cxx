@@ -0,0 +1,126 @@
+// C++
+#include <iostream>
+#include <stdexcept>
+
+// X11
+#include <X11/Xutil.h>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/GraphicsContext.hxx>
+#include <xpp/helpers.hxx>
+#include <xpp/Image.hxx>
+#include <xpp/Pixmap.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+namespace {
+
+constexpr xpp::Extent EXTENT{64, 48};
+
+uint32_t pattern(const unsigned x, const unsigned y, const uint32_t seed) {
+	return (x * 4) << 16 | (y * 4) << 8 | seed;
+}
+
+void fill(xpp::Image &image, const uint32_t seed) {
+	for (unsigned y = 0; y < EXTENT.height; y++) {
+		auto row = reinterpret_cast<uint32_t*>(image.row(y));
+		for (unsigned x = 0; x < EXTENT.width; x++) {
+			row[x] = pattern(x, y, seed);
+		}
+	}
+}
+
+/// Reads back `pixmap` and compares it against the expected pattern in `area`.
+void verify(const xpp::Pixmap &pixmap, const xpp::WindowSpec area,
+		const xpp::Coord src, const uint32_t seed) {
+	auto got = ::XGetImage(xpp::display, cosmos::to_integral(pixmap.id()),
+			area.x, area.y, area.width, area.height, AllPlanes, ZPixmap);
+
+	if (!got) {
+		throw std::runtime_error{"failed to read back pixmap"};
+	}
+
+	bool mismatch = false;
+
+	for (unsigned y = 0; y < area.height; y++) {
+		for (unsigned x = 0; x < area.width; x++) {
+			const auto expected = pattern(x + src.x, y + src.y, seed);
+			if ((XGetPixel(got, x, y) & 0xffffff) != expected) {
+				mismatch = true;
+			}
+		}
+	}
+
+	XDestroyImage(got);
+
+	if (mismatch) {
+		throw std::runtime_error{"pixmap contents don't match uploaded image"};
+	}
+}
+
+} // end anon ns
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	xpp::XWindow win{xpp::display.createWindow({0, 0, EXTENT.width, EXTENT.height}, 0)};
+	xpp::Pixmap pixmap{win.id(), EXTENT};
+	xpp::GraphicsContext gc{xpp::to_drawable(pixmap.id()), xpp::GcOptMask{}, XGCValues{}};
+
+	for (const bool use_shm: {true, false}) {
+		xpp::Image image{EXTENT, xpp::Image::UseShm{use_shm}};
+
+		std::cout << "image uses MIT-SHM: " << (image.isShared() ? "yes" : "no") << std::endl;
+
+		if (!use_shm && image.isShared()) {
+			throw std::runtime_error{"shared memory used although disabled"};
+		}
+
+		if (image.extent().width != EXTENT.width || image.bytesPerLine() < EXTENT.width) {
+			throw std::runtime_error{"bad image geometry"};
+		}
+
+		if (image.bitsPerPixel() != 32) {
+			std::cout << "skipping pixel checks for " << image.bitsPerPixel() << " bits per pixel" << std::endl;
+			continue;
+		}
+
+		const uint32_t seed = use_shm ? 0x11 : 0x22;
+		fill(image, seed);
+
+		// the image is movable, also while shared memory is attached
+		xpp::Image moved{std::move(image)};
+		if (image.valid() || !moved.valid()) {
+			throw std::runtime_error{"bad image move semantics"};
+		}
+
+		moved.putImage(pixmap, gc);
+		moved.waitIdle();
+		verify(pixmap, {0, 0, EXTENT.width, EXTENT.height}, {0, 0}, seed);
+
+		// now a sub-rectangle of the image at a different position
+		fill(moved, seed + 1);
+		moved.putImage(pixmap, gc, xpp::Coord{4, 8}, xpp::WindowSpec{10, 20, 16, 16});
+		moved.waitIdle();
+		verify(pixmap, {4, 8, 16, 16}, {10, 20}, seed + 1);
+	}
+
+	win.destroy();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
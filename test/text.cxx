@@ -0,0 +1,86 @@
+// C++
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// xpp
+#include <xpp/text.hxx>
+
+using namespace std::string_view_literals;
+
+namespace {
+
+void check(const bool cond, const std::string &what) {
+	if (!cond) {
+		throw std::runtime_error{what};
+	}
+}
+
+void test_level(const xpp::text::SimdLevel level) {
+	using xpp::text::split_list;
+	using xpp::text::is_valid_utf8;
+
+	const auto selected = xpp::text::set_simd_level(level);
+	const auto label = " (level " + std::to_string(static_cast<int>(selected)) + ")";
+	std::vector<std::string_view> parts;
+
+	check(split_list(""sv, parts) && parts.empty(), "empty input" + label);
+
+	check(split_list("one\0two\0"sv, parts), "terminated list" + label);
+	check(parts == std::vector{"one"sv, "two"sv}, "terminated list parts" + label);
+
+	check(split_list("one\0\0three"sv, parts), "unterminated list" + label);
+	check(parts == std::vector{"one"sv, ""sv, "three"sv}, "unterminated list parts" + label);
+
+	// long enough to pass through the vectorized code paths, with
+	// separators and multi-byte sequences crossing block boundaries
+	std::string names;
+	std::vector<std::string> expected;
+	for (int i = 0; i < 40; i++) {
+		expected.push_back("Desktop " + std::to_string(i) + (i % 3 == 0 ? " ä€\U0001F600" : ""));
+		names += expected.back();
+		names.push_back('\0');
+	}
+
+	check(split_list(names, parts), "long list" + label);
+	check(parts.size() == expected.size(), "long list size" + label);
+	for (size_t i = 0; i < parts.size(); i++) {
+		check(parts[i] == expected[i], "long list entry " + std::to_string(i) + label);
+	}
+
+	// broken encodings are reported, but splitting still works
+	auto broken = names;
+	broken[names.size() - 5] = '\xff';
+	check(!split_list(broken, parts) && parts.size() == expected.size(), "invalid list" + label);
+
+	check(is_valid_utf8("ä€\U0001F600"sv), "valid sequences" + label);
+	check(!is_valid_utf8("\xc0\xaf"sv), "overlong encoding" + label);
+	check(!is_valid_utf8("\xed\xa0\x80"sv), "surrogate" + label);
+	check(!is_valid_utf8("\xf4\x90\x80\x80"sv), "beyond U+10FFFF" + label);
+	check(!is_valid_utf8("\xe2\x82"sv), "truncated sequence" + label);
+	check(!is_valid_utf8("\xe2\0\x82"sv), "NUL within sequence" + label);
+}
+
+} // end anon ns
+
+void test() {
+	std::cout << "detected SIMD level " << static_cast<int>(xpp::text::detected_simd_level()) << "\n";
+
+	for (const auto level: {xpp::text::SimdLevel::SCALAR, xpp::text::SimdLevel::SSE2, xpp::text::SimdLevel::AVX2}) {
+		test_level(level);
+	}
+
+	xpp::text::set_simd_level(xpp::text::detected_simd_level());
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
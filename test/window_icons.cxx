@@ -0,0 +1,188 @@
+// C++
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/atoms.hxx>
+#include <xpp/Property.hxx>
+#include <xpp/WindowIcons.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+namespace {
+
+/// Appends an icon of the given size and pixel value to `data`.
+void add_icon(std::vector<long> &data, const unsigned width, const unsigned height, const uint32_t pixel) {
+	data.push_back(width);
+	data.push_back(height);
+	data.insert(data.end(), size_t{width} * height, pixel);
+}
+
+void test_narrow() {
+	// cover all vector tail lengths
+	for (size_t count = 0; count < 40; count++) {
+		std::vector<long> in;
+		for (size_t i = 0; i < count; i++) {
+			// upper bits as set by Xlib for sign extended values
+			in.push_back(static_cast<long>(static_cast<int32_t>(0x80000000u | (i * 0x01010101u))));
+		}
+
+		std::vector<uint32_t> out(count + 1, 0xdeadbeef);
+		xpp::narrow_format32(in.data(), count, out.data());
+
+		for (size_t i = 0; i < count; i++) {
+			if (out[i] != static_cast<uint32_t>(in[i])) {
+				throw std::runtime_error{"narrowing mismatch"};
+			}
+		}
+
+		if (out[count] != 0xdeadbeef) {
+			throw std::runtime_error{"narrowing overrun"};
+		}
+	}
+}
+
+void test_parse() {
+	std::vector<long> data;
+	add_icon(data, 16, 16, 0xff102030);
+	// zero sized icons are skipped
+	add_icon(data, 0, 5, 0);
+	add_icon(data, 32, 32, 0x80ffffff);
+	add_icon(data, 64, 48, 0xff000000);
+
+	xpp::WindowIcons icons;
+	icons.parse(data.data(), data.size());
+
+	if (icons.size() != 3 || icons[1].extent.width != 32 || icons[1].pixels.size() != 32 * 32) {
+		throw std::runtime_error{"unexpected icon list"};
+	}
+
+	if (icons[0].pixels[255] != 0xff102030 || icons[2].pixels[0] != 0xff000000) {
+		throw std::runtime_error{"unexpected pixel data"};
+	}
+
+	if (icons.pixelBytes() != (16 * 16 + 32 * 32 + 64 * 48) * sizeof(uint32_t)) {
+		throw std::runtime_error{"unexpected pixel memory"};
+	}
+
+	if (icons.best({24, 24})->extent.width != 32 || icons.best({128, 128})->extent.width != 64) {
+		throw std::runtime_error{"unexpected best icon"};
+	}
+
+	// a truncated trailing icon is ignored
+	data.push_back(8);
+	data.push_back(8);
+	data.push_back(0);
+	icons.parse(data.data(), data.size());
+
+	if (icons.size() != 3) {
+		throw std::runtime_error{"truncated icon not ignored"};
+	}
+
+	// an exactly matching icon is kept as is
+	icons.parse(data.data(), data.size(), xpp::Extent{32, 32});
+
+	if (icons.size() != 1 || icons[0].extent.width != 32 || icons[0].pixels[0] != 0x80ffffff) {
+		throw std::runtime_error{"unexpected selected icon"};
+	}
+
+	// smaller icons are not upscaled
+	icons.parse(data.data(), data.size(), xpp::Extent{256, 256});
+
+	if (icons.size() != 1 || icons[0].extent.width != 64 || icons[0].extent.height != 48) {
+		throw std::runtime_error{"icon was rescaled unexpectedly"};
+	}
+
+	// downscaling keeps the aspect ratio
+	icons.parse(data.data(), data.size(), xpp::Extent{40, 40});
+
+	if (icons.size() != 1 || icons[0].extent.width != 40 || icons[0].extent.height != 30) {
+		throw std::runtime_error{"unexpected downscaled extent"};
+	}
+
+	if (icons.pixelBytes() != 40 * 30 * sizeof(uint32_t) || icons[0].pixels[40 * 30 - 1] != 0xff000000) {
+		throw std::runtime_error{"unexpected downscaled pixels"};
+	}
+}
+
+void test_downscale_alpha() {
+	// a checkerboard of opaque red and fully transparent green pixels
+	std::vector<long> data{4, 4};
+	for (unsigned y = 0; y < 4; y++) {
+		for (unsigned x = 0; x < 4; x++) {
+			data.push_back((x + y) % 2 ? 0x0000ff00 : 0xffff0000);
+		}
+	}
+
+	xpp::WindowIcons icons;
+	icons.parse(data.data(), data.size(), xpp::Extent{2, 2});
+
+	// the transparent pixels must not contribute any colour
+	for (const auto pixel: icons[0].pixels) {
+		if (pixel != 0x7fff0000) {
+			throw std::runtime_error{"transparent pixels bleed into downscaled icon"};
+		}
+	}
+}
+
+void test_window() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	xpp::XWindow win{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+
+	xpp::WindowIcons icons;
+	if (win.tryGetIcons(icons) != xpp::PropertyStatus::NOT_EXISTING || !icons.empty()) {
+		throw std::runtime_error{"icons reported for window without icons"};
+	}
+
+	std::vector<long> data;
+	add_icon(data, 16, 16, 0xff00ff00);
+	add_icon(data, 48, 48, 0xff0000ff);
+	const std::vector<int> items(data.begin(), data.end());
+	win.setProperty(xpp::atoms::ewmh_wm_icon, xpp::Property<std::vector<int>>{items});
+
+	win.getIcons(icons);
+	if (icons.size() != 2 || icons[1].extent.width != 48 || icons[1].pixels[0] != 0xff0000ff) {
+		throw std::runtime_error{"unexpected icons from window"};
+	}
+
+	win.getIcons(icons, xpp::Extent{24, 24});
+	if (icons.size() != 1 || icons[0].extent.width != 24 || icons[0].pixels[0] != 0xff0000ff) {
+		throw std::runtime_error{"unexpected downscaled icon from window"};
+	}
+
+	xpp::Property<xpp::WindowIcons> prop;
+	win.getProperty(xpp::atoms::ewmh_wm_icon, prop);
+	if (prop.get().size() != 2) {
+		throw std::runtime_error{"unexpected icons via Property"};
+	}
+
+	win.destroy();
+}
+
+} // end anon ns
+
+void test() {
+	test_narrow();
+	test_parse();
+	test_downscale_alpha();
+	test_window();
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}
@@ -0,0 +1,71 @@
+// C++
+#include <iostream>
+
+// cosmos
+#include <cosmos/cosmos.hxx>
+#include <cosmos/io/StdLogger.hxx>
+
+// xpp
+#include <xpp/Event.hxx>
+#include <xpp/RootWin.hxx>
+#include <xpp/WindowTreeCache.hxx>
+#include <xpp/XDisplay.hxx>
+#include <xpp/XWindow.hxx>
+#include <xpp/Xpp.hxx>
+
+void process_events(xpp::WindowTreeCache &cache) {
+	xpp::Event event;
+	xpp::display.sync();
+
+	while (xpp::display.hasPendingEvents()) {
+		xpp::display.nextEvent(event);
+		cache.processEvent(event);
+	}
+}
+
+void test() {
+	cosmos::Init cosmos_init;
+	cosmos::StdLogger logger;
+	xpp::Init init(&logger);
+
+	xpp::RootWin root;
+	xpp::WindowTreeCache cache{root};
+	cache.seed();
+
+	std::cout << "seeded cache with " << cache.size() << " windows\n";
+
+	xpp::XWindow win{xpp::display.createWindow({0, 0, 100, 100}, 0)};
+	process_events(cache);
+
+	if (cache.parent(win.id()) != root.id() || cache.isMapped(win.id())) {
+		throw std::runtime_error{"new window not correctly cached"};
+	}
+
+	xpp::display.mapWindow(win);
+	process_events(cache);
+
+	if (!cache.isMapped(win.id())) {
+		throw std::runtime_error{"mapped state not updated"};
+	}
+
+	if (cache.verify() != 0) {
+		throw std::runtime_error{"cache differs from X server state"};
+	}
+
+	win.destroy();
+	process_events(cache);
+
+	if (cache.contains(win.id())) {
+		throw std::runtime_error{"destroyed window still cached"};
+	}
+}
+
+int main() {
+	try {
+		test();
+		return 0;
+	} catch (const std::exception &ex) {
+		std::cerr << "test failed: " << ex.what() << std::endl;
+		return 1;
+	}
+}